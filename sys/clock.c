@@ -2,9 +2,15 @@
 #include "machine.h"
 #include "process.h"
 #include "memory.h"
+#include "jit.h"
+#include "log.h"
+#include "event.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
 
 // Global frequency of the clock. Default 1 Hz
 int CLOCK_FREQUENCY_HZ = 1;
@@ -14,76 +20,535 @@ pthread_cond_t clk_cond = PTHREAD_COND_INITIALIZER;   // Condición para que tim
 pthread_cond_t clk_cond2 = PTHREAD_COND_INITIALIZER;  // Condición para que reloj espere por timers
 volatile int clk_counter = 0;
 
+// Tick barrier: every registered participant checks in once per tick (epoch = tick).
+// Protected by clk_mutex. Entries are kept after leaving for the final statistics.
+typedef struct {
+    char name[32];
+    int active;
+    int external;            // Checks in through another barrier (exec workers)
+    int arrived_tick;        // Last tick it checked in for
+    unsigned long arrivals;
+    unsigned long timeouts;  // Ticks the clock stopped waiting for it
+    long long latency_total_ns;  // From the start of the tick to its check-in
+    long long latency_max_ns;
+    int parked;              // Tickless idle: out of the barrier until woken
+    int wake_event;          // Event type that wakes it (-1 = only clock_wake_tick_participant)
+    int parked_tick;
+    unsigned long suppressed;  // Ticks it was not woken for while parked
+} TickParticipant;
+
+static TickParticipant* tb_participants = NULL;
+static int tb_count = 0;
+static int tb_capacity = 0;
+static int tb_pending = 0;           // Participants still to check in for the current tick
+static long long tb_tick_start_ns = 0;
+static unsigned long tb_ticks = 0;   // Ticks measured
+static unsigned long tb_timeouts = 0;  // Ticks completed by the timeout
+static long long tb_tick_total_ns = 0;  // Tick completion time (start to last check-in)
+static long long tb_tick_max_ns = 0;
+
+// Max wait of the clock for the participants of one tick, 0 = no limit
+int TICK_TIMEOUT_MS = 0;
+
+// Tickless idle (disabled by default): idle participants park until their next event
+int TICKLESS_ENABLED = 0;
+pthread_cond_t clk_idle_cond = PTHREAD_COND_INITIALIZER;  // Parked participants wait here
+static int clk_released = 0;   // Virtual time: set once the system is running
+
+// Achieved rate: wall time from the first tick to stop_clock()
+static struct timespec clk_start_time;
+static int clk_started = 0;
+static double clk_elapsed = 0.0;
+
+// Real-time pacing: tick N starts at clk_start_time + N periods (absolute deadlines)
+static long clk_missed = 0;             // Ticks whose deadline had already passed
+static long long clk_late_total_ns = 0;  // Sum of the lateness of the missed ticks
+static long long clk_late_max_ns = 0;    // Worst lateness
+static long long clk_drift_ns = 0;       // Lateness of the last tick (behind schedule)
+
 // Machine reference to decrement TTL of executing processes
 Machine* clock_machine_ref = NULL;
 PhysicalMemory* clock_pm_ref = NULL;
+static Scheduler* clock_sched_ref = NULL;
+static int clock_dispatch = 0;  // The cores pick from the per-core queues in this tick
+
+// Discrete-event mode (disabled by default: every tick is simulated)
+int DES_ENABLED = 0;
+
+// Future events of the simulation, protected by clk_mutex
+static EventQueue clock_events = {NULL, 0, 0};
+static int clk_skipped = 0;    // Idle ticks jumped over
+
+// Execution mode of the per-tick instruction phase (EXEC_MODE_SERIAL by default)
+int EXEC_MODE = EXEC_MODE_SERIAL;
+
+// Instructions each hardware thread may retire per tick (1 by default)
+int INSTRUCTIONS_PER_TICK = 1;
+
+// Max instructions per core per tick, shared by its busy hardware threads (0 = no cap)
+int CORE_INSTRUCTION_CAP = 0;
+
+// Parallel execution engine: one host worker per simulated Core.
+// The clock releases all workers through exec_start and waits on exec_done,
+// so every hardware thread advances exactly one tick per clock tick.
+typedef struct {
+    int cpu_idx;
+    int core_idx;
+    Core* core;
+    pthread_t thread;
+    LogBuffer log;      // Log records of this core for the current tick
+    int participant;    // Its entry in the tick barrier statistics
+    long long done_ns;  // When it finished the current tick
+} ExecWorker;
+
+static ExecWorker* exec_workers = NULL;
+static int num_exec_workers = 0;
+static volatile int exec_workers_shutdown = 0;
+static pthread_barrier_t exec_start;
+static pthread_barrier_t exec_done;
+static pthread_mutex_t exec_pool_mutex = PTHREAD_MUTEX_INITIALIZER;  // Held while the pool is being built
+
+static long long timespec_to_ns(const struct timespec* ts) {
+    return ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+static long long clock_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return timespec_to_ns(&now);
+}
+
+// Execute up to 'budget' instructions of the process on hw_thread.
+// Stops early on EXIT or on a page fault. Returns the number of instructions retired.
+static int clock_execute_budget(HardwareThread* hw_thread, int budget) {
+    int executed = 0;
+    
+    while (executed < budget && hw_thread->pcb->state != TERMINATED) {
+        int remaining = budget - executed;
+        
+        // Host code first (if enabled); the interpreter handles everything else
+        if (JIT_ENABLED) {
+            int n = jit_execute_block(hw_thread, clock_pm_ref, remaining);
+            if (n > 0) {
+                executed += n;
+                continue;
+            }
+        }
+        if (EXEC_INTERPRETER == INTERP_THREADED) {
+            int n = execute_instruction_block(hw_thread, clock_pm_ref, remaining);
+            executed += n;
+            // The block only stops short of its budget on EXIT or a fault
+            if (n < remaining) break;
+        } else {
+            int status = execute_instruction_cycle(hw_thread, clock_pm_ref);
+            executed++;
+            if (status < 0) break;
+        }
+    }
+    return executed;
+}
+
+// One tick for one hardware thread: decrement TTL of its process and execute up to
+// 'budget' instructions.
+static void clock_tick_hw_thread(int i, int j, int k, HardwareThread* hw_thread, int budget) {
+    // Skip if no PCB assigned
+    if (!hw_thread->pcb) return;
+    
+    PCB* pcb = hw_thread->pcb;
+    
+    // Decrement TTL
+    int old_ttl = pcb->ttl;
+    int new_ttl = decrement_pcb_ttl(pcb);
+    
+    LOG_EVENT(LOG_LEVEL_TICK, "[Clock] CPU%d-Core%d-Thread%d: PID=%d TTL: %d -> %d\n",
+              i, j, k, pcb->pid, old_ttl, new_ttl);
+    
+    // FASE 2: Execute instruction cycle if memory is available
+    if (clock_pm_ref && pcb->state != TERMINATED && budget > 0) {
+        LOG_EVENT(LOG_LEVEL_INSTR, "[Exec] CPU%d-Core%d-Thread%d: PID=%d executing... ",
+                  i, j, k, pcb->pid);
+        pcb->retired_instructions += clock_execute_budget(hw_thread, budget);
+    }
+}
+
+// One tick for every hardware thread of a core, after it took its processes from
+// the per-core queues (RR_LOCAL, MUQSS).
+// With a core cap, the cap is split evenly between the busy hardware threads
+// (the remainder goes to the lowest thread indexes), bounded by INSTRUCTIONS_PER_TICK.
+// kernel.c keeps the cap at or above the threads per core, so every busy thread
+// retires at least one instruction per tick (the rate the loader's TTL assumes).
+static void clock_tick_core(int i, int j, Core* core) {
+    if (clock_dispatch) {
+        scheduler_dispatch_core(clock_sched_ref, i * clock_machine_ref->cores_per_cpu + j);
+    }
+    
+    int busy = 0;
+    if (CORE_INSTRUCTION_CAP > 0) {
+        for (int k = 0; k < core->num_kernel_threads; k++) {
+            if (core->hw_threads[k].pcb && core->hw_threads[k].pcb->state != TERMINATED) busy++;
+        }
+    }
+    
+    int slot = 0;
+    for (int k = 0; k < core->num_kernel_threads; k++) {
+        HardwareThread* hw_thread = &core->hw_threads[k];
+        int budget = INSTRUCTIONS_PER_TICK;
+        if (busy > 0 && hw_thread->pcb && hw_thread->pcb->state != TERMINATED) {
+            int share = CORE_INSTRUCTION_CAP / busy + (slot < CORE_INSTRUCTION_CAP % busy ? 1 : 0);
+            if (share < 1) share = 1;
+            if (share < budget) budget = share;
+            slot++;
+        }
+        clock_tick_hw_thread(i, j, k, hw_thread, budget);
+    }
+}
+
+// Worker thread: waits for the clock, advances every hardware thread of its core, reports back
+static void* exec_worker_function(void* arg) {
+    ExecWorker* worker = (ExecWorker*)arg;
+    
+    // Log records of this host thread go to the worker buffer
+    log_set_capture(&worker->log);
+    
+    // Wait until the whole pool exists (or its creation was aborted)
+    pthread_mutex_lock(&exec_pool_mutex);
+    pthread_mutex_unlock(&exec_pool_mutex);
+    if (exec_workers_shutdown) return NULL;
+    
+    // Shutdown is only checked after exec_start: stop_exec_workers() always arrives there
+    while (1) {
+        pthread_barrier_wait(&exec_start);
+        if (exec_workers_shutdown) break;
+        
+        clock_tick_core(worker->cpu_idx, worker->core_idx, worker->core);
+        worker->done_ns = clock_now_ns();
+        
+        pthread_barrier_wait(&exec_done);
+    }
+    return NULL;
+}
+
+// Account one check-in of a participant. Called with clk_mutex held.
+static void clock_record_arrival(TickParticipant* p, long long latency) {
+    p->arrivals++;
+    p->latency_total_ns += latency;
+    if (latency > p->latency_max_ns) p->latency_max_ns = latency;
+}
+
+// Run the instruction phase of one tick on the worker pool.
+// Called by the clock thread with clk_mutex held.
+static void clock_execute_parallel(void) {
+    int old_state;
+    // Workers are parked on the barriers: don't let a cancel leave them half-way
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &old_state);
+    
+    pthread_barrier_wait(&exec_start);
+    pthread_barrier_wait(&exec_done);
+    
+    // Replay per-core records in CPU/Core order: same trace as the serial loop
+    for (int w = 0; w < num_exec_workers; w++) {
+        log_replay(&exec_workers[w].log);
+        if (exec_workers[w].participant >= 0) {
+            clock_record_arrival(&tb_participants[exec_workers[w].participant],
+                                 exec_workers[w].done_ns - tb_tick_start_ns);
+        }
+    }
+    
+    pthread_setcancelstate(old_state, NULL);
+}
+
+// Number of ticks that can be jumped over before the next one: the machine is idle
+// (nothing executing or ready) and no event is due until then. Called with clk_mutex held.
+// Quantum and TTL expirations need a running process, so they never happen while idle.
+static int clock_idle_ticks(void) {
+    if (!clock_sched_ref || scheduler_has_pending_work(clock_sched_ref)) return 0;
+    int next = event_next_tick(&clock_events);
+    if (next <= clk_counter + 1) return 0;  // Also no event at all: keep ticking
+    return next - clk_counter - 1;
+}
+
+// Deadline of the tick 'ticks' periods after the start. Computed from the start every
+// time, so the rounding of a non-integer period (e.g. 3 MHz) never accumulates.
+static long long clock_deadline_ns(long long start_ns, long long ticks) {
+    return start_ns + (long long)((__int128)ticks * 1000000000LL / CLOCK_FREQUENCY_HZ);
+}
+
+// Wait until an absolute CLOCK_MONOTONIC deadline. Returns how late it was reached
+// (0 if the deadline was still ahead). Periods under CLOCK_SPIN_NS are shorter than
+// the wake-up latency of the kernel timer: their last stretch is busy-waited.
+static long long clock_wait_deadline(long long deadline_ns) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long late = timespec_to_ns(&now) - deadline_ns;
+    if (late >= 0) return late;
+    
+    long long period_ns = 1000000000LL / CLOCK_FREQUENCY_HZ;
+    long long sleep_until = period_ns < CLOCK_SPIN_NS ? deadline_ns - CLOCK_SPIN_NS : deadline_ns;
+    if (sleep_until > timespec_to_ns(&now)) {
+        struct timespec ts = {sleep_until / 1000000000LL, sleep_until % 1000000000LL};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+            if (!running) return 0;
+        }
+    }
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while (timespec_to_ns(&now) < deadline_ns);
+    return 0;
+}
+
+// Take a participant out of tickless idle. 'expected': it has to check in for the current tick
+static void clock_unpark(TickParticipant* p, int expected) {
+    int missed = clk_counter - p->parked_tick - 1;  // The current tick is handled on waking
+    if (missed > 0) p->suppressed += missed;
+    p->parked = 0;
+    p->active = 1;
+    p->arrived_tick = expected ? clk_counter - 1 : clk_counter;
+    pthread_cond_broadcast(&clk_idle_cond);
+}
+
+// Wake the parked participants whose event is due on this tick (mask of event types).
+// Called with clk_mutex held, before the tick is broadcast: the clock waits for them.
+static void clock_wake_parked(int due) {
+    for (int p = 0; p < tb_count; p++) {
+        TickParticipant* part = &tb_participants[p];
+        if (part->parked && part->wake_event >= 0 && (due & (1 << part->wake_event))) {
+            clock_unpark(part, 1);
+        }
+    }
+}
+
+// Wait until every participant checked in for the current tick, or TICK_TIMEOUT_MS.
+// Called with clk_mutex held.
+static void clock_wait_participants(void) {
+    struct timespec deadline;
+    if (TICK_TIMEOUT_MS > 0) {
+        clock_gettime(CLOCK_REALTIME, &deadline);  // clk_cond2 uses the default clock
+        long long ns = deadline.tv_nsec + (TICK_TIMEOUT_MS % 1000) * 1000000LL;
+        deadline.tv_sec += TICK_TIMEOUT_MS / 1000 + ns / 1000000000LL;
+        deadline.tv_nsec = ns % 1000000000LL;
+    }
+    
+    while (running && tb_pending > 0) {
+        if (TICK_TIMEOUT_MS == 0) {
+            pthread_cond_wait(&clk_cond2, &clk_mutex);
+        } else if (pthread_cond_timedwait(&clk_cond2, &clk_mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    
+    if (tb_pending > 0 && running) {
+        // Timed out: go on without the late participants
+        for (int p = 0; p < tb_count; p++) {
+            TickParticipant* part = &tb_participants[p];
+            if (part->active && !part->external && part->arrived_tick != clk_counter) {
+                part->timeouts++;
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Clock] Tick %d: %s did not check in within %d ms\n",
+                           clk_counter, part->name, TICK_TIMEOUT_MS);
+            }
+        }
+        tb_timeouts++;
+    }
+    tb_pending = 0;
+    
+    long long elapsed = clock_now_ns() - tb_tick_start_ns;
+    tb_ticks++;
+    tb_tick_total_ns += elapsed;
+    if (elapsed > tb_tick_max_ns) tb_tick_max_ns = elapsed;
+}
+
+// stop_clock() cancels the clock thread, possibly inside a cond_wait on clk_mutex
+static void clock_unlock(void* arg) {
+    (void)arg; // Unused parameter
+    pthread_mutex_unlock(&clk_mutex);
+}
 
 // Clock increments clk_counter at desired frequency, decrements TTL of executing processes,
 // and signals waiting threads
 void* clock_function(void* arg) {
     (void)arg; // Unused parameter
     
+    if (CLOCK_FREQUENCY_HZ == CLOCK_FREQUENCY_MAX) {
+        // Virtual time: ticks are not paced, so don't run ahead of the system set-up
+        pthread_mutex_lock(&clk_mutex);
+        pthread_cleanup_push(clock_unlock, NULL);
+        while (running && !clk_released) {
+            pthread_cond_wait(&clk_cond2, &clk_mutex);
+        }
+        pthread_cleanup_pop(1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &clk_start_time);
+    clk_started = 1;
+    long long start_ns = timespec_to_ns(&clk_start_time);
+    int start_tick = clk_counter;
+    
     while (running) {
-        usleep(1000000 / CLOCK_FREQUENCY_HZ); // Wait one clock period
+        int skip = 0;
+        if (DES_ENABLED) {
+            pthread_mutex_lock(&clk_mutex);
+            skip = clock_idle_ticks();
+            pthread_mutex_unlock(&clk_mutex);
+        }
+        
+        if (CLOCK_FREQUENCY_HZ != CLOCK_FREQUENCY_MAX) {
+            // Wait for the deadline of the next tick (after the idle ticks being skipped).
+            // A late tick starts right away: the schedule is kept, not shifted.
+            long long deadline = clock_deadline_ns(start_ns, clk_counter + skip + 1 - start_tick);
+            long long late = clock_wait_deadline(deadline);
+            if (late > 0) {
+                clk_missed++;
+                clk_late_total_ns += late;
+                if (late > clk_late_max_ns) clk_late_max_ns = late;
+            }
+            clk_drift_ns = late;
+        }
         
         // Check again after sleep in case signal arrived during sleep
         if (!running) break;
         
         pthread_mutex_lock(&clk_mutex);
+        pthread_cleanup_push(clock_unlock, NULL);
+        
+        // Idle ticks: nothing would run, fire or be scheduled in them
+        if (skip > 0) {
+            int idle = clock_idle_ticks();
+            if (idle < skip) skip = idle;
+        }
+        if (skip > 0) {
+            LOG_EVENT(LOG_LEVEL_TICK, "\033[33mClock idle: ticks %d-%d skipped\033[0m\n",
+                      clk_counter + 1, clk_counter + skip);
+            clk_skipped += skip;
+        }
         
-        // Patrón T (reloj): Incrementar contador (done++)
-        clk_counter++;
+        // Patrón T (reloj): Incrementar contador (done++).
+        // Single atomic store: get_current_tick() reads it without clk_mutex
+        __atomic_store_n(&clk_counter, clk_counter + skip + 1, __ATOMIC_RELEASE);
+        int due = event_pop_due(&clock_events, clk_counter);
+        if (due) {
+            clock_wake_parked(due);
+        }
+        tb_tick_start_ns = clock_now_ns();
+        clock_dispatch = scheduler_take_dispatch(clock_sched_ref);
         
-        printf("\033[33mClock tick %d\033[0m\n", clk_counter);
-        fflush(stdout); // Force output immediately
+        LOG_EVENT(LOG_LEVEL_TICK, "\033[33mClock tick %d\033[0m\n", clk_counter);
         
         // CRITICAL: The system clock "moves" the executing processes
         // by decrementing their TTL on each tick
-        if (clock_machine_ref) {
+        if (clock_machine_ref && num_exec_workers > 0) {
+            clock_execute_parallel();
+        } else if (clock_machine_ref) {
             for (int i = 0; i < clock_machine_ref->num_CPUs; i++) {
                 for (int j = 0; j < clock_machine_ref->cpus[i].num_cores; j++) {
-                    Core* core = &clock_machine_ref->cpus[i].cores[j];
-                    
-                    // For each hardware thread in this core
-                    for (int k = 0; k < core->num_kernel_threads; k++) {
-                        HardwareThread* hw_thread = &core->hw_threads[k];
-                        
-                        // Skip if no PCB assigned
-                        if (!hw_thread->pcb) continue;
-                        
-                        PCB* pcb = hw_thread->pcb;
-                        
-                        // Decrement TTL
-                        int old_ttl = pcb->ttl;
-                        int new_ttl = decrement_pcb_ttl(pcb);
-                        
-                        printf("[Clock] CPU%d-Core%d-Thread%d: PID=%d TTL: %d -> %d\n",
-                               i, j, k, pcb->pid, old_ttl, new_ttl);
-                        fflush(stdout);
-                        
-                        // FASE 2: Execute instruction cycle if memory is available
-                        if (clock_pm_ref && pcb->state != TERMINATED) {
-                            printf("[Exec] CPU%d-Core%d-Thread%d: PID=%d executing... ", 
-                                   i, j, k, pcb->pid);
-                            fflush(stdout);
-                            execute_instruction_cycle(hw_thread, clock_pm_ref);
-                        }
-                    }
+                    clock_tick_core(i, j, &clock_machine_ref->cpus[i].cores[j]);
                 }
             }
         }
         
-        // Patrón T: Señalizar a los timers (cond_signal)
+        // Patrón T: Señalizar a los timers y al scheduler (cond_signal)
+        tb_pending = 0;
+        for (int p = 0; p < tb_count; p++) {
+            if (tb_participants[p].active && !tb_participants[p].external) tb_pending++;
+        }
         pthread_cond_broadcast(&clk_cond);
         
-        // Patrón T: Esperar confirmación de los timers (cond_wait con cond2)
-        pthread_cond_wait(&clk_cond2, &clk_mutex);
+        // Patrón T: Esperar confirmación de todos los participantes (cond_wait con cond2).
+        // The execution workers already finished this tick (exec_done barrier).
+        clock_wait_participants();
         
-        pthread_mutex_unlock(&clk_mutex);
+        pthread_cleanup_pop(1);
     }
     return NULL;
 }
 
+// Start one execution worker per Core of the clock's machine (EXEC_MODE_PARALLEL)
+int start_exec_workers(void) {
+    Machine* machine = clock_machine_ref;
+    if (!machine || num_exec_workers > 0) return -1;
+    
+    int total_cores = 0;
+    for (int i = 0; i < machine->num_CPUs; i++) {
+        total_cores += machine->cpus[i].num_cores;
+    }
+    
+    ExecWorker* workers = calloc(total_cores, sizeof(ExecWorker));
+    if (!workers) return -1;
+    
+    int w = 0;
+    for (int i = 0; i < machine->num_CPUs; i++) {
+        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
+            workers[w].cpu_idx = i;
+            workers[w].core_idx = j;
+            workers[w].core = &machine->cpus[i].cores[j];
+            w++;
+        }
+    }
+    
+    pthread_barrier_init(&exec_start, NULL, total_cores + 1);
+    pthread_barrier_init(&exec_done, NULL, total_cores + 1);
+    exec_workers_shutdown = 0;
+    
+    pthread_mutex_lock(&exec_pool_mutex);
+    for (w = 0; w < total_cores; w++) {
+        int ret = pthread_create(&workers[w].thread, NULL, exec_worker_function, &workers[w]);
+        if (ret != 0) {
+            // Barriers are sized for the full pool: release the workers already created and give up
+            fprintf(stderr, "Error creating execution worker thread: %s\n", strerror(ret));
+            exec_workers_shutdown = 1;
+            pthread_mutex_unlock(&exec_pool_mutex);
+            for (int l = 0; l < total_cores; l++) {
+                if (l < w) pthread_join(workers[l].thread, NULL);
+                log_buffer_destroy(&workers[l].log);
+            }
+            pthread_barrier_destroy(&exec_start);
+            pthread_barrier_destroy(&exec_done);
+            free(workers);
+            return -1;
+        }
+    }
+    pthread_mutex_unlock(&exec_pool_mutex);
+    
+    // Publish the pool to the clock only once all workers are waiting for ticks
+    pthread_mutex_lock(&clk_mutex);
+    for (w = 0; w < total_cores; w++) {
+        // They check in through exec_done: entries for the latency statistics only
+        char name[32];
+        int tick;
+        snprintf(name, sizeof(name), "Exec CPU%d-Core%d", workers[w].cpu_idx, workers[w].core_idx);
+        workers[w].participant = clock_join_tick_barrier(name, &tick);
+        if (workers[w].participant >= 0) {
+            tb_participants[workers[w].participant].external = 1;
+        }
+    }
+    exec_workers = workers;
+    num_exec_workers = total_cores;
+    pthread_mutex_unlock(&clk_mutex);
+    
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Clock] Parallel execution: %d worker threads (one per core)\n", total_cores);
+    return 0;
+}
+
+// Stop the execution workers. Must be called after the clock thread has been stopped.
+void stop_exec_workers(void) {
+    if (num_exec_workers == 0) return;
+    
+    // Release the workers parked on exec_start and let them see the shutdown flag
+    exec_workers_shutdown = 1;
+    pthread_barrier_wait(&exec_start);
+    
+    for (int w = 0; w < num_exec_workers; w++) {
+        pthread_join(exec_workers[w].thread, NULL);
+        log_buffer_destroy(&exec_workers[w].log);
+        pthread_mutex_lock(&clk_mutex);
+        clock_leave_tick_barrier(exec_workers[w].participant);
+        pthread_mutex_unlock(&clk_mutex);
+    }
+    
+    pthread_barrier_destroy(&exec_start);
+    pthread_barrier_destroy(&exec_done);
+    free(exec_workers);
+    exec_workers = NULL;
+    num_exec_workers = 0;
+}
+
 // Start the system clock
 int start_clock(pthread_t* clock_thread) {
     int ret = pthread_create(clock_thread, NULL, clock_function, NULL);
@@ -98,15 +563,169 @@ int start_clock(pthread_t* clock_thread) {
 void stop_clock(pthread_t clock_thread) {
     pthread_cancel(clock_thread);
     pthread_join(clock_thread, NULL);
+    
+    pthread_mutex_lock(&clk_mutex);
+    event_queue_destroy(&clock_events);
+    pthread_mutex_unlock(&clk_mutex);
+    
+    if (clk_started) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        clk_elapsed = (now.tv_sec - clk_start_time.tv_sec) + (now.tv_nsec - clk_start_time.tv_nsec) / 1e9;
+    }
 }
 
-// Get current tick count (thread-safe)
-int get_current_tick(void) {
-    int tick;
+// Real-time deadlines missed, their mean and worst lateness and how far behind
+// schedule the last tick started, in microseconds (valid after stop_clock)
+void get_clock_deadline_statistics(long* missed, double* mean_late_us, double* max_late_us, double* drift_us) {
+    *missed = clk_missed;
+    *mean_late_us = clk_missed > 0 ? clk_late_total_ns / 1000.0 / clk_missed : 0.0;
+    *max_late_us = clk_late_max_ns / 1000.0;
+    *drift_us = clk_drift_ns / 1000.0;
+}
+
+// Let a virtual time clock start ticking
+void release_clock(void) {
     pthread_mutex_lock(&clk_mutex);
-    tick = clk_counter;
+    clk_released = 1;
+    pthread_cond_broadcast(&clk_cond2);
     pthread_mutex_unlock(&clk_mutex);
-    return tick;
+}
+
+// Ticks done, idle ticks skipped and wall time they took (valid after stop_clock)
+void get_clock_statistics(int* ticks, int* skipped, double* seconds) {
+    *ticks = clk_counter;
+    *skipped = clk_skipped;
+    *seconds = clk_elapsed;
+}
+
+// Join the tick barrier. Called with clk_mutex held.
+// Stores the current tick in *tick: the first tick to check in for is the next one.
+// Returns the participant id, -1 on error
+int clock_join_tick_barrier(const char* name, int* tick) {
+    if (tb_count == tb_capacity) {
+        int capacity = tb_capacity ? tb_capacity * 2 : 8;
+        TickParticipant* participants = realloc(tb_participants, capacity * sizeof(TickParticipant));
+        if (!participants) {
+            fprintf(stderr, "Error joining tick barrier: %s\n", name);
+            return -1;
+        }
+        tb_participants = participants;
+        tb_capacity = capacity;
+    }
+    
+    TickParticipant* p = &tb_participants[tb_count];
+    memset(p, 0, sizeof(TickParticipant));
+    snprintf(p->name, sizeof(p->name), "%s", name);
+    p->active = 1;
+    p->arrived_tick = clk_counter;  // Not expected for a tick already in progress
+    *tick = clk_counter;
+    return tb_count++;
+}
+
+// Leave the tick barrier. Called with clk_mutex held.
+// If the clock is waiting for it in the current tick, it stops waiting.
+void clock_leave_tick_barrier(int id) {
+    if (id < 0 || id >= tb_count) return;
+    TickParticipant* p = &tb_participants[id];
+    if (!p->active) return;
+    
+    p->active = 0;
+    if (tb_pending > 0 && p->arrived_tick != clk_counter) {
+        tb_pending--;
+    }
+    pthread_cond_broadcast(&clk_cond2);
+}
+
+// A participant finished its work for 'tick'. Called with clk_mutex held.
+// Check-ins for a tick the clock already left (after a timeout) are ignored.
+void clock_tick_arrive(int id, int tick) {
+    if (id < 0 || id >= tb_count) return;
+    TickParticipant* p = &tb_participants[id];
+    if (tick != clk_counter || p->arrived_tick == tick) return;
+    
+    p->arrived_tick = tick;
+    clock_record_arrival(p, clock_now_ns() - tb_tick_start_ns);
+    if (tb_pending > 0 && --tb_pending == 0) {
+        pthread_cond_broadcast(&clk_cond2);
+    }
+}
+
+// Tickless idle: leave the barrier until the clock pops an event of type 'wake_event'
+// (-1 = none) or clock_wake_tick_participant() is called. Also returns when *keep_running
+// or running drop to 0 (the caller's stop path broadcasts clk_idle_cond).
+// Called with clk_mutex held, after checking in. Returns the current tick.
+int clock_tick_idle(int id, int wake_event, volatile int* keep_running) {
+    if (id < 0 || id >= tb_count) return clk_counter;
+    TickParticipant* p = &tb_participants[id];
+    if (!p->active) return clk_counter;
+    
+    p->active = 0;
+    p->parked = 1;
+    p->wake_event = wake_event;
+    p->parked_tick = clk_counter;
+    if (tb_pending > 0 && p->arrived_tick != clk_counter) {
+        tb_pending--;
+        pthread_cond_broadcast(&clk_cond2);
+    }
+    
+    // The array may grow while we sleep: index it again every time
+    while (tb_participants[id].parked && *keep_running && running) {
+        pthread_cond_wait(&clk_idle_cond, &clk_mutex);
+    }
+    tb_participants[id].parked = 0;
+    return clk_counter;
+}
+
+// New work for a parked participant: it rejoins the barrier from the next tick on
+// (it handles the current one right away). Called with clk_mutex held.
+void clock_wake_tick_participant(int id) {
+    if (id < 0 || id >= tb_count || !tb_participants[id].parked) return;
+    clock_unpark(&tb_participants[id], 0);
+}
+
+// Participants of the tick barrier (including the ones that left)
+int clock_num_tick_participants(void) {
+    return tb_count;
+}
+
+// Check-ins, mean and worst latency (microseconds from the start of the tick),
+// timeouts and suppressed wakeups (tickless idle) of one participant. Returns its name, NULL if id is not valid
+const char* get_tick_participant_statistics(int id, unsigned long* arrivals, double* mean_us,
+                                            double* max_us, unsigned long* timeouts,
+                                            unsigned long* suppressed) {
+    if (id < 0 || id >= tb_count) return NULL;
+    TickParticipant* p = &tb_participants[id];
+    *suppressed = p->suppressed;
+    *arrivals = p->arrivals;
+    *mean_us = p->arrivals > 0 ? p->latency_total_ns / 1000.0 / p->arrivals : 0.0;
+    *max_us = p->latency_max_ns / 1000.0;
+    *timeouts = p->timeouts;
+    return p->name;
+}
+
+// Tick completion time (start of the tick to the last check-in) and ticks ended by the timeout
+void get_tick_barrier_statistics(double* mean_us, double* max_us, unsigned long* timeouts) {
+    *mean_us = tb_ticks > 0 ? tb_tick_total_ns / 1000.0 / tb_ticks : 0.0;
+    *max_us = tb_tick_max_ns / 1000.0;
+    *timeouts = tb_timeouts;
+}
+
+// Schedule a future event. Called with clk_mutex held.
+void clock_schedule_event(int tick, int type, int id) {
+    if (event_push(&clock_events, tick, type, id) != 0) {
+        fprintf(stderr, "Error scheduling clock event (type %d) for tick %d\n", type, tick);
+    }
+}
+
+// Cancel the pending events of one source. Called with clk_mutex held.
+void clock_cancel_events(int type, int id) {
+    event_cancel(&clock_events, type, id);
+}
+
+// Get current tick count (thread-safe, lock-free: only the clock writes it)
+int get_current_tick(void) {
+    return __atomic_load_n(&clk_counter, __ATOMIC_ACQUIRE);
 }
 
 // Set the machine reference for the clock to decrement TTL
@@ -116,6 +735,14 @@ void set_clock_machine(Machine* machine) {
     pthread_mutex_unlock(&clk_mutex);
 }
 
+// Set the scheduler whose queues tell the discrete-event mode if the machine is idle
+// (and, with per-core queues, from which the cores pick in their tick phase)
+void set_clock_scheduler(Scheduler* sched) {
+    pthread_mutex_lock(&clk_mutex);
+    clock_sched_ref = sched;
+    pthread_mutex_unlock(&clk_mutex);
+}
+
 // Set the physical memory reference for instruction execution
 void set_clock_physical_memory(PhysicalMemory* pm) {
     pthread_mutex_lock(&clk_mutex);
@@ -4,11 +4,35 @@
 #include <pthread.h>
 #include "memory.h"
 
-// Forward declaration
+// Forward declarations
 typedef struct Machine Machine;
+typedef struct Scheduler Scheduler;
 
 // Global clock frequency (Hz)
 extern int CLOCK_FREQUENCY_HZ;
+#define CLOCK_FREQUENCY_MAX 0  // -f max: virtual time, next tick as soon as every consumer acked
+
+// Periods shorter than this (above 20 kHz) busy-wait the end of each period
+#define CLOCK_SPIN_NS 50000
+
+// Execution mode of the per-tick instruction phase
+#define EXEC_MODE_SERIAL   0  // Clock thread walks every hardware thread (default)
+#define EXEC_MODE_PARALLEL 1  // One host worker thread per Core, synchronized per tick
+extern int EXEC_MODE;
+
+// Instructions per tick: per hardware thread, and optional cap per core (0 = no cap)
+extern int INSTRUCTIONS_PER_TICK;
+extern int CORE_INSTRUCTION_CAP;
+
+// Max wait of the clock for the tick barrier participants (ms), 0 = no limit
+extern int TICK_TIMEOUT_MS;
+
+// Tickless idle mode and the condition parked participants wait on (with clk_mutex)
+extern int TICKLESS_ENABLED;
+extern pthread_cond_t clk_idle_cond;
+
+// Discrete-event mode: an idle machine jumps straight to the next event's tick
+extern int DES_ENABLED;
 
 // Global tick counter
 extern volatile int clk_counter;
@@ -32,5 +56,33 @@ void stop_clock(pthread_t clock_thread);
 int get_current_tick(void);
 void set_clock_machine(Machine* machine);
 void set_clock_physical_memory(PhysicalMemory* pm);
+int start_exec_workers(void);
+void stop_exec_workers(void);
+void set_clock_scheduler(Scheduler* sched);  // Idle check of the discrete-event mode
+void release_clock(void);  // Virtual time: start ticking (the system is set up)
+void get_clock_statistics(int* ticks, int* skipped, double* seconds);
+void get_clock_deadline_statistics(long* missed, double* mean_late_us, double* max_late_us, double* drift_us);
+
+// Tick barrier: the clock waits every tick until each participant (timer dispatcher,
+// scheduler, process generator) checks in, or TICK_TIMEOUT_MS. Called with clk_mutex held.
+int clock_join_tick_barrier(const char* name, int* tick);  // Returns the id, *tick = current tick
+void clock_leave_tick_barrier(int id);
+void clock_tick_arrive(int id, int tick);  // Done with 'tick'
+
+// Tickless idle: an idle participant parks off the barrier until its next event is due
+// (the clock wakes it on that tick) or until it is given work. Called with clk_mutex held.
+int clock_tick_idle(int id, int wake_event, volatile int* keep_running);  // Returns the current tick
+void clock_wake_tick_participant(int id);
+
+// Tick barrier statistics (exec workers included)
+int clock_num_tick_participants(void);
+const char* get_tick_participant_statistics(int id, unsigned long* arrivals, double* mean_us,
+                                            double* max_us, unsigned long* timeouts,
+                                            unsigned long* suppressed);
+void get_tick_barrier_statistics(double* mean_us, double* max_us, unsigned long* timeouts);
+
+// Future events (EVENT_* in event.h). Called with clk_mutex held.
+void clock_schedule_event(int tick, int type, int id);
+void clock_cancel_events(int type, int id);
 
 #endif // CLOCK_SYS_H
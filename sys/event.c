@@ -0,0 +1,101 @@
+#include "event.h"
+#include <stdlib.h>
+
+// Restore the heap property from position i upwards
+static void event_sift_up(EventQueue* eq, int i) {
+    SimEvent ev = eq->events[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (eq->events[parent].tick <= ev.tick) break;
+        eq->events[i] = eq->events[parent];
+        i = parent;
+    }
+    eq->events[i] = ev;
+}
+
+// Restore the heap property from position i downwards
+static void event_sift_down(EventQueue* eq, int i) {
+    SimEvent ev = eq->events[i];
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= eq->size) break;
+        if (child + 1 < eq->size && eq->events[child + 1].tick < eq->events[child].tick) child++;
+        if (ev.tick <= eq->events[child].tick) break;
+        eq->events[i] = eq->events[child];
+        i = child;
+    }
+    eq->events[i] = ev;
+}
+
+// Remove the earliest event
+static void event_remove_first(EventQueue* eq) {
+    eq->size--;
+    if (eq->size == 0) return;
+    eq->events[0] = eq->events[eq->size];
+    event_sift_down(eq, 0);
+}
+
+// Initialize an empty event queue
+void event_queue_init(EventQueue* eq) {
+    eq->events = NULL;
+    eq->size = 0;
+    eq->capacity = 0;
+}
+
+// Free the events of a queue
+void event_queue_destroy(EventQueue* eq) {
+    free(eq->events);
+    event_queue_init(eq);
+}
+
+// Schedule an event. Returns 0 on success, -1 on error
+int event_push(EventQueue* eq, int tick, int type, int id) {
+    if (eq->size == eq->capacity) {
+        int capacity = eq->capacity ? eq->capacity * 2 : 16;
+        SimEvent* events = realloc(eq->events, capacity * sizeof(SimEvent));
+        if (!events) return -1;
+        eq->events = events;
+        eq->capacity = capacity;
+    }
+    eq->events[eq->size].tick = tick;
+    eq->events[eq->size].type = type;
+    eq->events[eq->size].id = id;
+    eq->size++;
+    event_sift_up(eq, eq->size - 1);
+    return 0;
+}
+
+// Tick of the earliest event, -1 if there is none
+int event_next_tick(EventQueue* eq) {
+    return eq->size > 0 ? eq->events[0].tick : -1;
+}
+
+// Drop every event scheduled up to 'tick' (they have happened).
+// Returns the types that were due as a mask (1 << type)
+int event_pop_due(EventQueue* eq, int tick) {
+    int types = 0;
+    while (eq->size > 0 && eq->events[0].tick <= tick) {
+        types |= 1 << eq->events[0].type;
+        event_remove_first(eq);
+    }
+    return types;
+}
+
+// Drop the pending events of one source (timer destroyed, generator stopped)
+// Returns how many were dropped
+int event_cancel(EventQueue* eq, int type, int id) {
+    int kept = 0;
+    for (int i = 0; i < eq->size; i++) {
+        if (eq->events[i].type != type || eq->events[i].id != id) {
+            eq->events[kept++] = eq->events[i];
+        }
+    }
+    int count = eq->size - kept;
+    eq->size = kept;
+
+    // Rebuild the heap
+    for (int i = eq->size / 2 - 1; i >= 0; i--) {
+        event_sift_down(eq, i);
+    }
+    return count;
+}
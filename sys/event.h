@@ -0,0 +1,30 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+// Future event types known to the clock
+#define EVENT_TIMER           0  // Timer expiration (id = timer id)
+#define EVENT_PROCESS_ARRIVAL 1  // Next process created by the generator
+
+// Event scheduled for a future tick
+typedef struct {
+    int tick;
+    int type;
+    int id;
+} SimEvent;
+
+// Min-heap of events ordered by tick
+typedef struct {
+    SimEvent* events;
+    int size;
+    int capacity;
+} EventQueue;
+
+// Function declarations
+void event_queue_init(EventQueue* eq);
+void event_queue_destroy(EventQueue* eq);
+int event_push(EventQueue* eq, int tick, int type, int id);  // 0 on success, -1 on error
+int event_next_tick(EventQueue* eq);        // Tick of the earliest event, -1 if empty
+int event_pop_due(EventQueue* eq, int tick);  // Drop events up to 'tick', returns the mask of their types
+int event_cancel(EventQueue* eq, int type, int id);  // Drop the events of one source
+
+#endif // EVENT_H
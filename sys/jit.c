@@ -0,0 +1,321 @@
+#include "jit.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+// JIT switch (enabled with -jit 1)
+int JIT_ENABLED = 0;
+
+// Host code of a block: void block(uint32_t* registers, int budget)
+// Entered at the host offset of any of its instructions, it returns after 'budget'
+// instructions or at the end of the block, whichever comes first
+typedef void (*jit_code_t)(uint32_t* registers, int budget);
+
+// Data access performed by a block: the block reads and writes host memory directly,
+// so accessed/dirty bits and decoded cache invalidation are applied after it runs
+typedef struct {
+    uint32_t physical_word;
+    uint32_t virtual_page;
+    uint16_t instruction;  // Index of the LD/ST in the block
+    uint8_t store;         // 1 = ST, 0 = LD
+} JitAccess;
+
+// Translated block. In the code buffer the header is followed by its accesses, the host
+// offset of each instruction and the host code
+typedef struct {
+    uint16_t num_instructions;
+    uint16_t num_accesses;
+    uint8_t size_class;         // Free list it goes back to
+    JitAccess* accesses;
+    uint16_t* entry;            // Host code offset of each instruction
+    uint8_t* code;
+} JitBlock;
+
+// Code buffer: bump allocated, blocks dropped by the decoded cache go back to a free
+// list per size class. When it is full the JIT stops translating and everything runs
+// in the interpreter (blocks already translated stay valid).
+#define JIT_MIN_CLASS_SIZE 64
+#define JIT_NUM_SIZE_CLASSES 8  // 64 bytes .. 8 KB
+static uint8_t* code_buffer = NULL;
+static size_t code_used = 0;
+static void* free_blocks[JIT_NUM_SIZE_CLASSES];
+static int buffer_full_reported = 0;
+static pthread_mutex_t jit_mutex = PTHREAD_MUTEX_INITIALIZER;  // Execution workers share the buffer
+
+// Statistics (protected by jit_mutex)
+static unsigned long jit_translations = 0;
+static unsigned long jit_reclaimed = 0;
+static size_t jit_bytes_in_use = 0;
+
+// Map the executable code buffer
+int jit_init(void) {
+#if defined(__x86_64__)
+    if (code_buffer) return 0;
+    
+    void* buffer = mmap(NULL, JIT_CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        perror("Error: JIT code buffer");
+        return -1;
+    }
+    code_buffer = buffer;
+    code_used = 0;
+    memset(free_blocks, 0, sizeof(free_blocks));
+    host_code_release = jit_release_block;
+    return 0;
+#else
+    fprintf(stderr, "Error: JIT only supports x86-64 hosts\n");
+    return -1;
+#endif
+}
+
+// Unmap the code buffer
+void jit_shutdown(void) {
+    if (code_buffer) {
+        host_code_release = NULL;
+        munmap(code_buffer, JIT_CODE_BUFFER_SIZE);
+        code_buffer = NULL;
+        code_used = 0;
+    }
+}
+
+// Reserve a block of at least 'size' bytes: a freed block of its size class, or new
+// space in the code buffer. NULL if full.
+static JitBlock* jit_alloc(size_t size) {
+    int size_class = 0;
+    while ((size_t)(JIT_MIN_CLASS_SIZE << size_class) < size) size_class++;
+    if (size_class >= JIT_NUM_SIZE_CLASSES) return NULL;
+    size_t class_size = (size_t)JIT_MIN_CLASS_SIZE << size_class;
+    JitBlock* block = NULL;
+    
+    pthread_mutex_lock(&jit_mutex);
+    if (free_blocks[size_class]) {
+        block = free_blocks[size_class];
+        free_blocks[size_class] = *(void**)block;
+    } else if (code_used + class_size <= JIT_CODE_BUFFER_SIZE) {
+        block = (JitBlock*)(code_buffer + code_used);
+        code_used += class_size;
+    } else if (!buffer_full_reported) {
+        fprintf(stderr, "Warning: JIT code buffer full, interpreting from now on\n");
+        buffer_full_reported = 1;
+    }
+    if (block) {
+        block->size_class = (uint8_t)size_class;
+        jit_translations++;
+        jit_bytes_in_use += class_size;
+    }
+    pthread_mutex_unlock(&jit_mutex);
+    
+    return block;
+}
+
+// Give back a block dropped by the decoded cache (its code was overwritten or its
+// frame freed). The cache no longer points to it.
+void jit_release_block(void* host_code) {
+    JitBlock* block = host_code;
+    int size_class = block->size_class;
+    
+    pthread_mutex_lock(&jit_mutex);
+    *(void**)block = free_blocks[size_class];
+    free_blocks[size_class] = block;
+    jit_reclaimed++;
+    jit_bytes_in_use -= (size_t)JIT_MIN_CLASS_SIZE << size_class;
+    pthread_mutex_unlock(&jit_mutex);
+}
+
+// Translations made, blocks given back and code buffer bytes held by live blocks
+void jit_get_statistics(unsigned long* translations, unsigned long* reclaimed, size_t* bytes_in_use) {
+    pthread_mutex_lock(&jit_mutex);
+    *translations = jit_translations;
+    *reclaimed = jit_reclaimed;
+    *bytes_in_use = jit_bytes_in_use;
+    pthread_mutex_unlock(&jit_mutex);
+}
+
+// x86-64 emitters. rdi = &hw_thread->registers[0], eax = scratch
+static uint8_t* emit_load_reg(uint8_t* p, uint8_t reg) {       // mov eax, [rdi + 4*reg]
+    *p++ = 0x8B; *p++ = 0x47; *p++ = (uint8_t)(reg * 4);
+    return p;
+}
+
+static uint8_t* emit_add_reg(uint8_t* p, uint8_t reg) {        // add eax, [rdi + 4*reg]
+    *p++ = 0x03; *p++ = 0x47; *p++ = (uint8_t)(reg * 4);
+    return p;
+}
+
+static uint8_t* emit_store_reg(uint8_t* p, uint8_t reg) {      // mov [rdi + 4*reg], eax
+    *p++ = 0x89; *p++ = 0x47; *p++ = (uint8_t)(reg * 4);
+    return p;
+}
+
+static uint8_t* emit_load_abs(uint8_t* p, const void* addr) {  // mov eax, [moffs64]
+    uint64_t a = (uint64_t)(uintptr_t)addr;
+    *p++ = 0xA1;
+    memcpy(p, &a, 8);
+    return p + 8;
+}
+
+static uint8_t* emit_store_abs(uint8_t* p, const void* addr) { // mov [moffs64], eax
+    uint64_t a = (uint64_t)(uintptr_t)addr;
+    *p++ = 0xA3;
+    memcpy(p, &a, 8);
+    return p + 8;
+}
+
+static uint8_t* emit_countdown(uint8_t* p) {                   // dec esi; jnz +1; ret
+    *p++ = 0xFF; *p++ = 0xCE;
+    *p++ = 0x75; *p++ = 0x01;
+    *p++ = 0xC3;
+    return p;
+}
+
+#define JIT_MAX_BYTES_PER_INSTRUCTION 24
+#define JIT_MAX_CODE_BYTES (MAX_TRANSLATION_LENGTH * JIT_MAX_BYTES_PER_INSTRUCTION + 1)
+
+// Translate the straight-line block starting at word 'start' of a code frame.
+// Data addresses are resolved through the page table now: the ISA only has absolute
+// addresses, so each LD/ST becomes a single move to/from its host address.
+// The block stops before a word that belongs to another block, so every word has at
+// most one translation.
+static JitBlock* jit_translate(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
+                               uint32_t frame, DecodedInstruction* frame_cache, uint32_t start) {
+    uint8_t code[JIT_MAX_CODE_BYTES];
+    uint8_t* p = code;
+    JitAccess accesses[MAX_TRANSLATION_LENGTH];
+    uint16_t entry[MAX_TRANSLATION_LENGTH];
+    uint16_t num_instructions = 0;
+    uint16_t num_accesses = 0;
+    
+    uint32_t frame_base = frame * FRAME_WORDS;
+    uint32_t word = start;
+    
+    while (word < FRAME_WORDS && num_instructions < MAX_TRANSLATION_LENGTH) {
+        DecodedInstruction* decoded = &frame_cache[word];
+        if (!decoded->valid) {
+            decode_instruction(decoded, pm->memory[frame_base + word], page_table, tlb);
+        } else if (decoded->host_code) {
+            break;  // Already translated by the block that follows
+        }
+        
+        int ends_block = 0;
+        entry[num_instructions] = (uint16_t)(p - code);
+        if (decoded->opcode == OP_ADD) {
+            p = emit_load_reg(p, decoded->src1);
+            p = emit_add_reg(p, decoded->src2);
+            p = emit_store_reg(p, decoded->reg);
+        } else if (decoded->opcode == OP_LD && decoded->translated) {
+            p = emit_load_abs(p, &pm->memory[decoded->data_address]);
+            p = emit_store_reg(p, decoded->reg);
+            accesses[num_accesses].physical_word = decoded->data_address;
+            accesses[num_accesses].virtual_page = decoded->address >> PAGE_OFFSET_BITS;
+            accesses[num_accesses].instruction = num_instructions;
+            accesses[num_accesses].store = 0;
+            num_accesses++;
+        } else if (decoded->opcode == OP_ST && decoded->translated) {
+            p = emit_load_reg(p, decoded->reg);
+            p = emit_store_abs(p, &pm->memory[decoded->data_address]);
+            accesses[num_accesses].physical_word = decoded->data_address;
+            accesses[num_accesses].virtual_page = decoded->address >> PAGE_OFFSET_BITS;
+            accesses[num_accesses].instruction = num_instructions;
+            accesses[num_accesses].store = 1;
+            num_accesses++;
+            // Store into the code that follows: stop so it is fetched again
+            if (decoded->data_address >= frame_base + start &&
+                decoded->data_address < frame_base + start + MAX_TRANSLATION_LENGTH) {
+                ends_block = 1;
+            }
+        } else {
+            break;  // EXIT, invalid opcode or page fault: interpreter
+        }
+        p = emit_countdown(p);
+        
+        num_instructions++;
+        word++;
+        if (ends_block) break;
+    }
+    
+    if (num_instructions == 0) return NULL;
+    *p++ = 0xC3;  // ret
+    
+    size_t code_size = (size_t)(p - code);
+    size_t accesses_size = num_accesses * sizeof(JitAccess);
+    size_t entry_size = num_instructions * sizeof(uint16_t);
+    JitBlock* block = jit_alloc(sizeof(JitBlock) + accesses_size + entry_size + code_size);
+    if (!block) return NULL;
+    
+    block->num_instructions = num_instructions;
+    block->num_accesses = num_accesses;
+    block->accesses = (JitAccess*)(block + 1);
+    block->entry = (uint16_t*)((uint8_t*)block->accesses + accesses_size);
+    block->code = (uint8_t*)block->entry + entry_size;
+    memcpy(block->accesses, accesses, accesses_size);
+    memcpy(block->entry, entry, entry_size);
+    memcpy(block->code, code, code_size);
+    
+    // Register the translation in every word it covers, with the instructions left to
+    // its end: execution can enter the block at any of them, and a write to any of
+    // them drops it
+    for (uint32_t i = 0; i < num_instructions; i++) {
+        frame_cache[start + i].host_code = block;
+        frame_cache[start + i].host_length = num_instructions - i;
+    }
+    
+    return block;
+}
+
+// Execute the translated block covering PC (translating it on first use), from the
+// instruction at PC and for at most max_instructions
+int jit_execute_block(HardwareThread* hw_thread, PhysicalMemory* pm, int max_instructions) {
+    if (!code_buffer || !DECODE_CACHE_ENABLED) return 0;
+    if (!hw_thread || !pm || !hw_thread->pcb || !hw_thread->PTBR) return 0;
+    if (hw_thread->pcb->state == TERMINATED || max_instructions <= 0) return 0;
+    
+    PageTableEntry* page_table = (PageTableEntry*)hw_thread->PTBR;
+    uint32_t page = hw_thread->PC >> PAGE_OFFSET_BITS;
+    uint32_t frame;
+    if (mmu_translate_page(page_table, &hw_thread->tlb, page, &frame) != 0) return 0;
+    
+    DecodedInstruction* frame_cache = get_decoded_frame(pm, frame);
+    if (!frame_cache) return 0;
+    
+    uint32_t word = (hw_thread->PC & ((1 << PAGE_OFFSET_BITS) - 1)) / WORD_SIZE;
+    JitBlock* block = frame_cache[word].valid ? frame_cache[word].host_code : NULL;
+    if (!block) {
+        block = jit_translate(pm, page_table, &hw_thread->tlb, frame, frame_cache, word);
+        if (!block) return 0;
+    }
+    
+    int first = block->num_instructions - frame_cache[word].host_length;
+    int executed = frame_cache[word].host_length;
+    if (executed > max_instructions) executed = max_instructions;
+    uint32_t last_instruction = frame_cache[word + executed - 1].raw;
+    
+    ((jit_code_t)(void*)(block->code + block->entry[first]))(hw_thread->registers, executed);
+    
+    // Side effects the host code skipped. The stores may drop this very block, so its
+    // accesses are copied first
+    JitAccess accesses[MAX_TRANSLATION_LENGTH];
+    int num_accesses = 0;
+    for (int a = 0; a < block->num_accesses; a++) {
+        int instruction = block->accesses[a].instruction;
+        if (instruction >= first && instruction < first + executed) {
+            accesses[num_accesses++] = block->accesses[a];
+        }
+    }
+    for (int a = 0; a < num_accesses; a++) {
+        page_table[accesses[a].virtual_page].accessed = 1;
+        if (accesses[a].store) {
+            page_table[accesses[a].virtual_page].dirty = 1;
+            invalidate_decoded_word(pm, accesses[a].physical_word);
+        }
+    }
+    
+    LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: [JIT] %d instructions\n", hw_thread->PC, executed);
+    
+    hw_thread->PC += 4 * executed;
+    hw_thread->IR = last_instruction;
+    return executed;
+}
@@ -0,0 +1,24 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include "machine.h"
+#include "memory.h"
+
+// Basic-block JIT: translates straight-line LD/ST/ADD sequences of a code page
+// into x86-64 host code. EXIT, invalid opcodes and page faults are left to the interpreter.
+
+#define JIT_CODE_BUFFER_SIZE (16 * 1024 * 1024)  // Executable buffer for translations (bytes)
+
+extern int JIT_ENABLED;  // 1 = try host code before interpreting (default: 0)
+
+int jit_init(void);       // Map the code buffer. Returns -1 if the JIT can't run on this host
+void jit_shutdown(void);
+
+// Execute the translated block covering PC, from PC and for at most max_instructions.
+// Returns the number of instructions executed, 0 if the caller must interpret.
+int jit_execute_block(HardwareThread* hw_thread, PhysicalMemory* pm, int max_instructions);
+
+void jit_release_block(void* host_code);  // Reuse the space of a dropped translation
+void jit_get_statistics(unsigned long* translations, unsigned long* reclaimed, size_t* bytes_in_use);
+
+#endif // JIT_H
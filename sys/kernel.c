@@ -4,12 +4,16 @@
 #include <signal.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <limits.h>
 #include "machine.h"
 #include "process.h"
 #include "clock.h"
 #include "timer.h"
 #include "memory.h"
 #include "loader.h"
+#include "jit.h"
+#include "tlb.h"
+#include "log.h"
 
 // Global variables for cleanup
 static pthread_t clk_thread_global;
@@ -30,7 +34,13 @@ void timer_scheduler_callback(int timer_id, void* user_data) {
     if (sched) {
         // Signal the scheduler to wake up and do its work
         pthread_mutex_lock(&sched->sched_mutex);
-        pthread_cond_signal(&sched->sched_cond);
+        unsigned long activation = ++sched->activations;
+        pthread_cond_broadcast(&sched->sched_cond);
+        
+        // Wait until it is done, so the timer only acks the tick afterwards
+        while (running && sched->running && sched->activations_done < activation) {
+            pthread_cond_wait(&sched->sched_cond, &sched->sched_mutex);
+        }
         pthread_mutex_unlock(&sched->sched_mutex);
     }
 }
@@ -39,8 +49,7 @@ void timer_scheduler_callback(int timer_id, void* user_data) {
 void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
     int scheduler_policy = SCHED_POLICY_ROUND_ROBIN;  // Default policy
     
-    printf("Stopping scheduler...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Stopping scheduler...\n");
     
     // Stop scheduler and print all running processes
     if (scheduler_global) {
@@ -50,19 +59,20 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
         // Print all processes currently executing in the machine
         if (machine_global) {
             int total_executing = count_executing_processes(machine_global);
-            printf("\tTotal processes executing: %d\n", total_executing);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tTotal processes executing: %d\n", total_executing);
             
             if (total_executing > 0) {
-                printf("\tProcesses by CPU, Core, and Kernel Thread:\n");
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tProcesses by CPU, Core, and Kernel Thread:\n");
                 for (int i = 0; i < machine_global->num_CPUs; i++) {
                     for (int j = 0; j < machine_global->cpus[i].num_cores; j++) {
                         Core* core = &machine_global->cpus[i].cores[j];
                         if (core->current_pcb_count > 0) {
-                            printf("\t  CPU%d - Core%d (%d/%d threads used):\n", 
+                            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  CPU%d - Core%d (%d/%d threads used):\n", 
                                    i, j, core->current_pcb_count, core->num_kernel_threads);
-                            for (int k = 0; k < core->current_pcb_count; k++) {
-                                PCB* pcb = &core->pcbs[k];
-                                printf("\t    Thread%d: PID=%d (TTL=%d, State=%d, Quantum=%d)\n", 
+                            for (int k = 0; k < core->num_kernel_threads; k++) {
+                                PCB* pcb = core->hw_threads[k].pcb;
+                                if (!pcb) continue;
+                                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t    Thread%d: PID=%d (TTL=%d, State=%d, Quantum=%d)\n", 
                                        k, pcb->pid, pcb->ttl, pcb->state, pcb->quantum_counter);
                             }
                         }
@@ -70,14 +80,12 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
                 }
             }
         } else {
-            printf("\tNo processes were running\n");
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tNo processes were running\n");
         }
-        fflush(stdout);
         
         // For preemptive priority policy, print processes in priority queues BEFORE destroying scheduler
         if (scheduler_global->policy == SCHED_POLICY_PREEMPTIVE_PRIO) {
-            printf("\tPriority queues content:\n");
-            fflush(stdout);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tPriority queues content:\n");
             
             if (scheduler_global->priority_queues) {
                 int total_in_priority_queues = 0;
@@ -88,12 +96,12 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
                     ProcessQueue* pq = scheduler_global->priority_queues[queue_idx];
                     
                     if (pq && pq->current_size > 0) {
-                        printf("\t  Priority %d: %d process(es)\n", prio, pq->current_size);
+                        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  Priority %d: %d process(es)\n", prio, pq->current_size);
                         
                         int idx = pq->front;
                         for (int i = 0; i < pq->current_size; i++) {
                             PCB* pcb = (PCB*)pq->queue[idx];
-                            printf("\t    PID=%d (TTL=%d)\n", pcb->pid, pcb->ttl);
+                            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t    PID=%d (TTL=%d)\n", pcb->pid, pcb->ttl);
                             idx = (idx + 1) % pq->max_capacity;
                         }
                         
@@ -102,23 +110,132 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
                 }
                 
                 if (total_in_priority_queues == 0) {
-                    printf("\t  (empty - all priority queues are empty)\n");
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  (empty - all priority queues are empty)\n");
                 } else {
-                    printf("\t  Total processes in priority queues: %d\n", total_in_priority_queues);
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  Total processes in priority queues: %d\n", total_in_priority_queues);
                 }
             } else {
-                printf("\t  (priority queues not initialized)\n");
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  (priority queues not initialized)\n");
+            }
+        }
+
+        // For BFS, print processes in the deadline queue BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_BFS && scheduler_global->bfs_queue) {
+            RunQueue* rq = scheduler_global->bfs_queue;
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tBFS run queue content: %d process(es)\n", rq->size);
+            for (int i = 0; i < rq->size; i++) {
+                PCB* pcb = (PCB*)run_queue_item(rq, i);
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  PID=%d (TTL=%d, Priority=%d, Deadline=%d)\n",
+                           pcb->pid, pcb->ttl, pcb->priority, pcb->virtual_deadline);
+            }
+        }
+
+        // For SRPT, print the processes and the work they have done BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_SRPT && scheduler_global->srpt_queue) {
+            RunQueue* rq = scheduler_global->srpt_queue;
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tSRPT run queue content: %d process(es)\n", rq->size);
+            for (int i = 0; i < rq->size; i++) {
+                PCB* pcb = (PCB*)run_queue_item(rq, i);
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  PID=%d (TTL=%d, Instructions=%lu/%lu)\n",
+                           pcb->pid, pcb->ttl, pcb->retired_instructions, pcb->total_instructions);
+            }
+        }
+
+        // For per-core round robin, print the local run queues BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_RR_LOCAL && scheduler_global->local_queues) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tLocal run queues: %d process(es) waiting, %lu stolen\n",
+                       scheduler_global->local_count, scheduler_global->steals);
+            for (int c = 0; c < scheduler_global->num_local_queues; c++) {
+                LocalRunQueue* lq = &scheduler_global->local_queues[c];
+                if (lq->queue->current_size == 0 && lq->stolen == 0) continue;
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  CPU%d-Core%d: %d waiting, %lu stolen from it\n",
+                           c / machine_global->cores_per_cpu, c % machine_global->cores_per_cpu,
+                           lq->queue->current_size, lq->stolen);
+            }
+        }
+
+        // For MuQSS, print the per-core deadline queues BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_MUQSS && scheduler_global->muqss_queues) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tMuQSS run queues: %d process(es) waiting, %lu stolen\n",
+                       scheduler_global->local_count, scheduler_global->steals);
+            for (int c = 0; c < scheduler_global->num_local_queues; c++) {
+                MuqssRunQueue* mq = &scheduler_global->muqss_queues[c];
+                if (mq->list->size == 0 && mq->stolen == 0) continue;
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  CPU%d-Core%d: %d waiting, %lu stolen from it\n",
+                           c / machine_global->cores_per_cpu, c % machine_global->cores_per_cpu,
+                           mq->list->size, mq->stolen);
+                for (SkipListNode* node = mq->list->head.next[0]; node; node = node->next[0]) {
+                    PCB* pcb = (PCB*)node->item;
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t    PID=%d (TTL=%d, Priority=%d, Deadline=%d)\n",
+                               pcb->pid, pcb->ttl, pcb->priority, pcb->virtual_deadline);
+                }
+            }
+        }
+
+        // For CFS, print the tree in vruntime order BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_CFS) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tCFS run queue content: %d process(es), min_vruntime=%llu\n",
+                       scheduler_global->cfs_tree.size, scheduler_global->min_vruntime);
+            for (RBNode* node = scheduler_global->cfs_tree.leftmost; node; node = rb_next(node)) {
+                PCB* pcb = rb_entry(node, PCB, run_node);
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  PID=%d (TTL=%d, Priority=%d, vruntime=%llu)\n",
+                           pcb->pid, pcb->ttl, pcb->priority, pcb->vruntime);
+            }
+        }
+
+        // For MLFQ, print the processes waiting at each level BEFORE destroying scheduler
+        if (scheduler_global->policy == SCHED_POLICY_MLFQ && scheduler_global->priority_queues) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tMLFQ levels content: %d process(es), %lu boost(s)\n",
+                       scheduler_global->prio_count, scheduler_global->boosts);
+            for (int level = 0; level < NUM_PRIORITY_LEVELS; level++) {
+                ProcessQueue* pq = scheduler_global->priority_queues[level];
+                if (pq->current_size == 0) continue;
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  Level %d: %d process(es)\n", level, pq->current_size);
+                int idx = pq->front;
+                for (int i = 0; i < pq->current_size; i++) {
+                    PCB* pcb = pq->queue[idx];
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t    PID=%d (TTL=%d)\n", pcb->pid, pcb->ttl);
+                    idx = (idx + 1) % pq->max_capacity;
+                }
             }
-            fflush(stdout);
         }
+
+        // Cost of picking processes: compare the global BFS queue with the per-core ones
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n=== Scheduler Statistics ===\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Policy: %s\n", scheduler_policy_name(scheduler_global->policy));
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Picks: %lu", scheduler_global->picks);
+        if (scheduler_global->picks > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, ", latency mean %.0f ns, max %lld ns",
+                       (double)scheduler_global->pick_ns_total / scheduler_global->picks,
+                       scheduler_global->pick_ns_max);
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Completed: %d", scheduler_global->total_completed);
+        if (scheduler_global->total_completed > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, ", mean turnaround %.1f ticks",
+                       (double)scheduler_global->turnaround_total / scheduler_global->total_completed);
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Global lock: %lu acquisitions, %lu contended\n",
+                   scheduler_global->global_lock_acquired, scheduler_global->global_lock_contended);
+        if (scheduler_global->num_local_queues > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "Per-core queue locks: %lu acquisitions, %lu contended, %lu steals\n",
+                       scheduler_global->queue_lock_acquired, scheduler_global->queue_lock_contended,
+                       scheduler_global->steals);
+            // Queue locks can only be contended when the cores pick at the same time
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "Per-core picks: %s\n", EXEC_MODE == EXEC_MODE_PARALLEL ?
+                       "in parallel, from the exec workers (without the global lock)" :
+                       "one core after another, from the clock thread");
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "============================\n\n");
         
+        set_clock_scheduler(NULL);
         destroy_scheduler(scheduler_global);
     }
     
     // ProcessGenerator disabled - using only .elf programs
     /*
-    printf("Stopping process generator...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Stopping process generator...\n");
     
     // Stop process generator
     if (proc_gen_global) {
@@ -127,16 +244,17 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
     }
     */
     
-    printf("Stopping clock...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Stopping clock...\n");
     stop_clock(clock_thread);
+    stop_exec_workers();
+    jit_shutdown();
     
-    printf("Stopping timers...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Stopping timers...\n");
     
     // Wake up all waiting threads before canceling
     pthread_mutex_lock(&clk_mutex);
     pthread_cond_broadcast(&clk_cond);
+    pthread_cond_broadcast(&clk_idle_cond);
     pthread_mutex_unlock(&clk_mutex);
     
     for (int i = 0; i < num_timers; i++) {
@@ -145,28 +263,26 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
         }
     }
     
-    printf("Cleaning ready queue...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Cleaning ready queue...\n");
     
     // Clean up ready queue and remaining processes
     if (ready_queue_global) {
-        printf("\tNumber of processes in ready_queue: %d\n", ready_queue_global->current_size);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tNumber of processes in ready_queue: %d\n", ready_queue_global->current_size);
         if (ready_queue_global->current_size > 0) {
-            printf("\tProcesses in ready_queue:\n");
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "\tProcesses in ready_queue:\n");
             int count = ready_queue_global->current_size;
             int idx = ready_queue_global->front;
             for (int i = 0; i < count; i++) {
                 PCB* pcb = (PCB*)ready_queue_global->queue[idx];
                 // Print priority only if policy uses it (BFS and Preemptive Priority)
-                if (scheduler_policy != SCHED_POLICY_ROUND_ROBIN) {
-                    printf("\t  PID=%d (TTL=%d, Priority=%d)\n", pcb->pid, pcb->ttl, pcb->priority);
+                if (scheduler_policy_uses_priority(scheduler_policy)) {
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  PID=%d (TTL=%d, Priority=%d)\n", pcb->pid, pcb->ttl, pcb->priority);
                 } else {
-                    printf("\t  PID=%d (TTL=%d)\n", pcb->pid, pcb->ttl);
+                    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\t  PID=%d (TTL=%d)\n", pcb->pid, pcb->ttl);
                 }
                 idx = (idx + 1) % ready_queue_global->max_capacity;
             }
         }
-        fflush(stdout);
         
         PCB* pcb;
         while ((pcb = dequeue_process(ready_queue_global)) != NULL) {
@@ -175,57 +291,143 @@ void cleanup_system(pthread_t clock_thread, Timer** timers, int num_timers) {
         destroy_process_queue(ready_queue_global);
     }
     
+    // Achieved clock rate (the only meaningful rate with -f max)
+    int clock_ticks, clock_skipped;
+    double clock_seconds;
+    get_clock_statistics(&clock_ticks, &clock_skipped, &clock_seconds);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n=== Clock Statistics ===\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Ticks: %d\n", clock_ticks);
+    if (DES_ENABLED) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Idle ticks skipped: %d\n", clock_skipped);
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Wall time: %.3f s\n", clock_seconds);
+    if (clock_seconds > 0) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Achieved rate: %.1f ticks/s\n", clock_ticks / clock_seconds);
+    }
+    if (CLOCK_FREQUENCY_HZ != CLOCK_FREQUENCY_MAX) {
+        // Real time: how well the host kept up with the requested frequency
+        long missed;
+        double mean_late_us, max_late_us, drift_us;
+        get_clock_deadline_statistics(&missed, &mean_late_us, &max_late_us, &drift_us);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Missed deadlines: %ld (mean late %.1f us, max %.1f us)\n",
+                   missed, mean_late_us, max_late_us);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Drift at last tick: %.1f us\n", drift_us);
+    }
+    
+    // Tick barrier: how long each tick took to complete and who it waited for
+    double tick_mean_us, tick_max_us;
+    unsigned long tick_timeouts;
+    get_tick_barrier_statistics(&tick_mean_us, &tick_max_us, &tick_timeouts);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Tick completion: mean %.1f us, max %.1f us", tick_mean_us, tick_max_us);
+    if (TICK_TIMEOUT_MS > 0) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, ", %lu timed out", tick_timeouts);
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n");
+    for (int p = 0; p < clock_num_tick_participants(); p++) {
+        unsigned long arrivals, timeouts, suppressed;
+        double mean_us, max_us;
+        const char* name = get_tick_participant_statistics(p, &arrivals, &mean_us, &max_us,
+                                                           &timeouts, &suppressed);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  %-20s check-ins: %lu, latency mean %.1f us, max %.1f us",
+                   name, arrivals, mean_us, max_us);
+        if (timeouts > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, ", timeouts: %lu", timeouts);
+        }
+        if (TICKLESS_ENABLED) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, ", suppressed wakeups: %lu", suppressed);
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n");
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "========================\n");
+    
     // Destroy machine (processes in cores are not dynamically allocated, just struct copies)
     if (machine_global) {
-        printf("Destroying machine...\n");
-        fflush(stdout);
+        unsigned long tlb_hits, tlb_misses, tlb_flushes_avoided;
+        get_tlb_statistics(machine_global, &tlb_hits, &tlb_misses, &tlb_flushes_avoided);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n=== TLB Statistics ===\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Hits: %lu\n", tlb_hits);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Misses (page table walks): %lu\n", tlb_misses);
+        if (tlb_hits + tlb_misses > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "Hit rate: %.2f%%\n", (tlb_hits * 100.0) / (tlb_hits + tlb_misses));
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Flushes avoided (ASID): %lu\n", tlb_flushes_avoided);
+        if (DECODE_CACHE_ENABLED) {
+            // LD/ST keep the address translated when they were decoded
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "(-dcache 1: data accesses use decode-time translations, "
+                       "only fetches and decoding reach the TLB)\n");
+        }
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "======================\n\n");
+        
+        if (JIT_ENABLED) {
+            unsigned long jit_translations, jit_reclaimed;
+            size_t jit_bytes;
+            jit_get_statistics(&jit_translations, &jit_reclaimed, &jit_bytes);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "=== JIT Statistics ===\n");
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "Translations: %lu, reclaimed: %lu\n", jit_translations, jit_reclaimed);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "Code buffer in use: %.1f KB of %d KB\n",
+                       jit_bytes / 1024.0, JIT_CODE_BUFFER_SIZE / 1024);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "======================\n\n");
+        }
+        
+
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Destroying machine...\n");
         destroy_machine(machine_global);
     }
     
     // Destroy loader
     if (loader_global) {
-        printf("Destroying loader...\n");
-        fflush(stdout);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Destroying loader...\n");
         destroy_loader(loader_global);
     }
     
     // Destroy physical memory
     if (physical_memory_global) {
-        printf("Destroying physical memory...\n");
-        fflush(stdout);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Destroying physical memory...\n");
         
         // Show memory usage statistics before destroying
-        printf("\n=== Memory Usage Statistics ===\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n=== Memory Usage Statistics ===\n");
         int used_frames = 0;
         for (int i = 0; i < TOTAL_FRAMES; i++) {
             if (is_frame_allocated(physical_memory_global, i)) {
                 used_frames++;
             }
         }
-        printf("Total frames: %d (%.2f MB)\n", TOTAL_FRAMES, (TOTAL_FRAMES * PAGE_SIZE) / (1024.0 * 1024.0));
-        printf("Used frames: %d (%.2f MB)\n", used_frames, (used_frames * PAGE_SIZE) / (1024.0 * 1024.0));
-        printf("Free frames: %d (%.2f MB)\n", TOTAL_FRAMES - used_frames, ((TOTAL_FRAMES - used_frames) * PAGE_SIZE) / (1024.0 * 1024.0));
-        printf("Memory utilization: %.2f%%\n", (used_frames * 100.0) / TOTAL_FRAMES);
-        printf("==============================\n\n");
-        fflush(stdout);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Total frames: %d (%.2f MB)\n", TOTAL_FRAMES, (TOTAL_FRAMES * PAGE_SIZE) / (1024.0 * 1024.0));
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Used frames: %d (%.2f MB)\n", used_frames, (used_frames * PAGE_SIZE) / (1024.0 * 1024.0));
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Free frames: %d (%.2f MB)\n", TOTAL_FRAMES - used_frames, ((TOTAL_FRAMES - used_frames) * PAGE_SIZE) / (1024.0 * 1024.0));
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Memory utilization: %.2f%%\n", (used_frames * 100.0) / TOTAL_FRAMES);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "==============================\n\n");
         
         destroy_physical_memory(physical_memory_global);
     }
     
-    printf("Destroying mutexes...\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Destroying mutexes...\n");
     pthread_mutex_destroy(&clk_mutex);
     pthread_cond_destroy(&clk_cond);
 }
 
+// Parse a clock frequency in Hz with an optional k/M/G suffix ("2.5M" = 2500000 Hz)
+// Returns the frequency clamped to [1, INT_MAX]
+static int parse_frequency(const char* text) {
+    char* end;
+    double hz = strtod(text, &end);
+    if (*end == 'k' || *end == 'K') hz *= 1e3;
+    else if (*end == 'M') hz *= 1e6;
+    else if (*end == 'G') hz *= 1e9;
+    if (!(hz >= 1.0)) return 1;
+    if (hz > INT_MAX) return INT_MAX;
+    return (int)hz;
+}
+
 // Catch Ctrl+C to clean up and exit successfully
 void handle_sigint(int sig) {
-    printf("\n\n\033[31mCaught signal %d, shutting down...", sig);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n\n\033[31mCaught signal %d, shutting down...", sig);
     running = 0;  // Signal main loop to exit
     
     // Wake up all waiting threads immediately
     pthread_mutex_lock(&clk_mutex);
     pthread_cond_broadcast(&clk_cond);
+    pthread_cond_broadcast(&clk_idle_cond);
     pthread_mutex_unlock(&clk_mutex);
     
     // Wake up scheduler if it's waiting on its own condition variable
@@ -256,12 +458,14 @@ int main(int argc, char *argv[]) {
     if (argc == 2 && strcmp(argv[1], "--help") == 0) {
         printf("Usage:\n   %s [flags]\n", argv[0]);
         printf("Flags:\n");
-        printf("   -f <hz>            Clock frequency in Hz (default: 1)\n");
+        printf("   -f <hz|max>        Clock frequency in Hz (k/M/G suffixes, e.g. 2M), max=virtual time (unthrottled) (default: 1)\n");
         printf("   -q <ticks>         Scheduler quantum (max ticks per process) (default: 3)\n");
         printf("   -t <num>           Number of timers (default: 1)\n");
         printf("   -timeri <ticks>    Interval for timer interruptions in ticks (default: 5)\n");
-        printf("   -policy <num>      Scheduler policy: 0=RR, 1=BFS, 2=PreemptivePrio (default: 0)\n");
+        printf("   -policy <num>      Scheduler policy: 0=RR, 1=BFS, 2=PreemptivePrio, 3=RR per-core queues, 4=MuQSS, 5=CFS, 6=MLFQ, 7=SRPT (default: 0)\n");
         printf("   -sync <mode>       Sync mode: 0=Clock, 1=Timer (default: 0)\n");
+        printf("   -cfslat <ticks>    CFS target latency, -q is the minimum granularity (default: 24)\n");
+        printf("   -boost <ticks>     MLFQ priority boost interval, 0=never (default: 100)\n");
         // Process generator disabled - these flags are no longer used
         // printf("   -pgenmin <ticks>   Min interval for process generation in ticks (default: 3)\n");
         // printf("   -pgenmax <ticks>   Max interval for process generation in ticks (default: 10)\n");
@@ -270,7 +474,22 @@ int main(int argc, char *argv[]) {
         printf("   -qsize <num>       Ready queue size (default: 100)\n");
         printf("   -cpus <num>        Number of CPUs (default: 1)\n");
         printf("   -cores <num>       Number of cores per CPU (default: 2)\n");
-        printf("   -threads <num>     Number of kernel threads per core (default: 4)\n");
+        printf("   -threads <num>     Number of kernel threads per core, max 64 (default: 4)\n");
+        printf("   -des <0|1>         Discrete-event mode: skip idle ticks up to the next event (default: 0)\n");
+        printf("   -nohz <0|1>        Tickless idle: idle scheduler/timers sleep until their next event (default: 0)\n");
+        printf("   -tickto <ms>       Max wait of the clock for timers/scheduler each tick, 0=no limit (default: 0)\n");
+        printf("   -par <mode>        Execution: 0=Serial clock loop, 1=One worker thread per core (default: 0)\n");
+        printf("   -ipc <num>         Instructions per tick per hardware thread (default: 1)\n");
+        printf("   -corecap <num>     Max instructions per tick per core, 0=no cap (default: 0)\n");
+        printf("   -dcache <0|1>      Decoded instruction cache (default: 1)\n");
+        printf("   -fuse <0|1>        Fuse LD/LD/ADD/ST groups into one operation (default: 1)\n");
+        printf("   -interp <mode>     Interpreter: 0=Switch, 1=Threaded block interpreter (default: 1)\n");
+        printf("   -jit <0|1>         Translate straight-line blocks to x86-64 host code (default: 0)\n");
+        printf("   -tlb <num>         TLB entries per hardware thread, 0=no TLB (default: 16)\n");
+        printf("   -tlbways <num>     TLB associativity, 0=fully associative (default: 0)\n");
+        printf("   -tlbpolicy <num>   TLB replacement: 0=Round Robin, 1=LRU, 2=Random (default: 0)\n");
+        printf("   -asid <0|1>        ASID-tagged TLB entries, 0=flush on every context switch (default: 1)\n");
+        printf("   -log <level>       Output: off, summary, tick, instr (or 0-3) (default: instr)\n");
         return 0;
     }
 
@@ -279,7 +498,11 @@ int main(int argc, char *argv[]) {
             if(i+1<argc){
                 if (strcmp(argv[i], "-f")==0) {
                     i++;
-                    CLOCK_FREQUENCY_HZ = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 1;
+                    if (strcmp(argv[i], "max")==0) {
+                        CLOCK_FREQUENCY_HZ = CLOCK_FREQUENCY_MAX;
+                    } else {
+                        CLOCK_FREQUENCY_HZ = parse_frequency(argv[i]);
+                    }
                 } else if (strcmp(argv[i], "-q")==0) {
                     i++;
                     quantum = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 5;
@@ -292,7 +515,7 @@ int main(int argc, char *argv[]) {
                 } else if (strcmp(argv[i], "-policy")==0) {
                     i++;
                     int policy = atoi(argv[i]);
-                    if (policy >= 0 && policy <= 2) {
+                    if (policy >= 0 && policy < SCHED_NUM_POLICIES) {
                         sched_policy = policy;
                     }
                 } else if (strcmp(argv[i], "-sync")==0) {
@@ -301,6 +524,12 @@ int main(int argc, char *argv[]) {
                     if (sync >= 0 && sync <= 1) {
                         sched_sync = sync;
                     }
+                } else if (strcmp(argv[i], "-cfslat")==0) {
+                    i++;
+                    CFS_TARGET_LATENCY = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 24;
+                } else if (strcmp(argv[i], "-boost")==0) {
+                    i++;
+                    MLFQ_BOOST_INTERVAL = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 0;
                 // Process generator disabled - these flags are ignored
                 /*
                 } else if (strcmp(argv[i], "-pgenmin")==0) {
@@ -328,11 +557,84 @@ int main(int argc, char *argv[]) {
                 } else if (strcmp(argv[i], "-threads")==0) {
                     i++;
                     num_threads = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 4;
+                    if (num_threads > MAX_HW_THREADS_PER_CORE) num_threads = MAX_HW_THREADS_PER_CORE;
+                } else if (strcmp(argv[i], "-nohz")==0) {
+                    i++;
+                    TICKLESS_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-tickto")==0) {
+                    i++;
+                    TICK_TIMEOUT_MS = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 0;
+                } else if (strcmp(argv[i], "-des")==0) {
+                    i++;
+                    DES_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-par")==0) {
+                    i++;
+                    int mode = atoi(argv[i]);
+                    if (mode >= EXEC_MODE_SERIAL && mode <= EXEC_MODE_PARALLEL) {
+                        EXEC_MODE = mode;
+                    }
+                } else if (strcmp(argv[i], "-ipc")==0) {
+                    i++;
+                    INSTRUCTIONS_PER_TICK = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 1;
+                } else if (strcmp(argv[i], "-corecap")==0) {
+                    i++;
+                    CORE_INSTRUCTION_CAP = (atoi(argv[i]) > 0) ? atoi(argv[i]) : 0;
+                } else if (strcmp(argv[i], "-dcache")==0) {
+                    i++;
+                    DECODE_CACHE_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-fuse")==0) {
+                    i++;
+                    FUSION_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-interp")==0) {
+                    i++;
+                    int interp = atoi(argv[i]);
+                    if (interp >= INTERP_SWITCH && interp <= INTERP_THREADED) {
+                        EXEC_INTERPRETER = interp;
+                    }
+                } else if (strcmp(argv[i], "-jit")==0) {
+                    i++;
+                    JIT_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-tlb")==0) {
+                    i++;
+                    TLB_ENTRIES = (atoi(argv[i]) >= 0) ? atoi(argv[i]) : 16;
+                } else if (strcmp(argv[i], "-tlbways")==0) {
+                    i++;
+                    TLB_WAYS = (atoi(argv[i]) >= 0) ? atoi(argv[i]) : 0;
+                } else if (strcmp(argv[i], "-tlbpolicy")==0) {
+                    i++;
+                    int policy = atoi(argv[i]);
+                    if (policy >= TLB_POLICY_RR && policy <= TLB_POLICY_RANDOM) {
+                        TLB_POLICY = policy;
+                    }
+                } else if (strcmp(argv[i], "-asid")==0) {
+                    i++;
+                    TLB_ASID_ENABLED = (atoi(argv[i]) != 0);
+                } else if (strcmp(argv[i], "-log")==0) {
+                    i++;
+                    int level = log_parse_level(argv[i]);
+                    if (level >= 0) {
+                        LOG_LEVEL = level;
+                    }
                 }
             }
         }
     }
     
+    // A core cap below the threads per core would leave busy threads without any
+    // instruction in a tick while their TTL and quantum still run: one per thread at least
+    if (CORE_INSTRUCTION_CAP > 0 && CORE_INSTRUCTION_CAP < num_threads) {
+        fprintf(stderr, "-corecap %d is below -threads %d, using %d\n",
+                CORE_INSTRUCTION_CAP, num_threads, num_threads);
+        CORE_INSTRUCTION_CAP = num_threads;
+    }
+    
+    // From here on stdout is written by the log thread (drained at exit)
+    if (log_start() == 0) {
+        atexit(log_stop);
+    } else {
+        fprintf(stderr, "Failed to start log writer, logging synchronously\n");
+    }
+    
     // Set up signal handler for Ctrl+C
     signal(SIGINT, handle_sigint);
    
@@ -365,7 +667,7 @@ int main(int argc, char *argv[]) {
     set_clock_machine(machine_global);
     
     // Create physical memory (FASE 2: Required for instruction execution)
-    printf("Creating physical memory...\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Creating physical memory...\n");
     physical_memory_global = create_physical_memory();
     if (!physical_memory_global) {
         fprintf(stderr, "Failed to create physical memory\n");
@@ -378,6 +680,18 @@ int main(int argc, char *argv[]) {
     // Set physical memory in clock for instruction execution
     set_clock_physical_memory(physical_memory_global);
     
+    // JIT code buffer (falls back to the interpreter if the host can't run it)
+    if (JIT_ENABLED && jit_init() != 0) {
+        fprintf(stderr, "JIT not available, using the interpreter\n");
+        JIT_ENABLED = 0;
+    }
+    
+    // Parallel execution engine: one host worker per simulated core
+    if (EXEC_MODE == EXEC_MODE_PARALLEL && start_exec_workers() != 0) {
+        fprintf(stderr, "Failed to start execution workers, using serial execution\n");
+        EXEC_MODE = EXEC_MODE_SERIAL;
+    }
+    
     // Calculate maximum usable kernel threads (limited by qsize)
     int total_threads = num_cpus * num_cores * num_threads;
     int max_usable_threads = (total_threads < ready_queue_size) ? total_threads : ready_queue_size;
@@ -463,7 +777,7 @@ int main(int argc, char *argv[]) {
     }
     
     // Create loader for .elf programs (FASE 2)
-    printf("Creating loader...\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Creating loader...\n");
     loader_global = create_loader(physical_memory_global, ready_queue_global,
                                   machine_global, scheduler_global);
     if (!loader_global) {
@@ -486,7 +800,7 @@ int main(int argc, char *argv[]) {
     
     // Load .elf programs from ~/the_locOS/programs/ directory
     // Each .elf file becomes ONE complete process with executable code
-    printf("Loading .elf programs from ~/the_locOS/programs/...\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Loading .elf programs from ~/the_locOS/programs/...\n");
     const char* programs_dir = "./../programs";
     DIR* dir = opendir(programs_dir);
     if (dir) {
@@ -501,7 +815,7 @@ int main(int argc, char *argv[]) {
                 snprintf(filepath, sizeof(filepath), "%s/%s", programs_dir, entry->d_name);
                 
                 // Load program and create process
-                printf("  Loading %s...\n", entry->d_name);
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Loading %s...\n", entry->d_name);
                 Program* prog = load_program_from_elf(filepath);
                 if (prog) {
                     PCB* pcb = create_process_from_program(loader_global, prog);
@@ -509,7 +823,7 @@ int main(int argc, char *argv[]) {
                         // Add to ready queue
                         if (enqueue_process(ready_queue_global, pcb) == 0) {
                             programs_loaded++;
-                            printf("  %s  -> Process %d added to ready queue\n", entry->d_name, pcb->pid);
+                            LOG_PRINTF(LOG_LEVEL_SUMMARY, "  %s  -> Process %d added to ready queue\n", entry->d_name, pcb->pid);
                         } else {
                             fprintf(stderr, "    -> Failed to enqueue process\n");
                             destroy_pcb(pcb);
@@ -523,7 +837,7 @@ int main(int argc, char *argv[]) {
         }
         closedir(dir);
         
-        printf("[Loader] %d programs loaded from .elf files\n", programs_loaded);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Loader] %d programs loaded from .elf files\n", programs_loaded);
     } else {
         fprintf(stderr, "Warning: Could not open programs directory '%s'\n", programs_dir);
         fprintf(stderr, "No .elf programs will be loaded\n");
@@ -557,42 +871,84 @@ int main(int argc, char *argv[]) {
     }
     */
     proc_gen_global = NULL;  // No process generator - only .elf programs
-    printf("Process creation: .elf programs only (ProcessGenerator disabled)\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Process creation: .elf programs only (ProcessGenerator disabled)\n");
     
     // Print system configuration BEFORE starting components
-    const char* policy_names[] = {"Round Robin", "BFS", "Preemptive Priority"};
     const char* sync_names[] = {"Global Clock", "Timer"};
+    const char* exec_names[] = {"Serial", "Parallel (one worker per core)"};
     
-    printf("\n\033[34m=== System Configuration ===\n");
-    printf("Clock frequency:      %d Hz\n", CLOCK_FREQUENCY_HZ);
-    printf("Scheduler:\n");
-    printf("  - Quantum:          %d ticks\n", quantum);
-    printf("  - Policy:           %s\n", policy_names[sched_policy]);
-    printf("  - Sync mode:        %s\n", sync_names[sched_sync]);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n\033[34m=== System Configuration ===\n");
+    if (CLOCK_FREQUENCY_HZ == CLOCK_FREQUENCY_MAX) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Clock frequency:      max (virtual time)\n");
+    } else {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Clock frequency:      %d Hz\n", CLOCK_FREQUENCY_HZ);
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Idle ticks:           %s\n", DES_ENABLED ? "skipped (discrete-event)" : "simulated");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Tickless idle:        %s\n", TICKLESS_ENABLED ? "on" : "off");
+    if (TICK_TIMEOUT_MS > 0) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Tick barrier timeout: %d ms\n", TICK_TIMEOUT_MS);
+    } else {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Tick barrier timeout: none\n");
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Execution:            %s\n", exec_names[EXEC_MODE]);
+    if (CORE_INSTRUCTION_CAP > 0) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Instructions/tick:    %d per thread, %d per core\n", INSTRUCTIONS_PER_TICK, CORE_INSTRUCTION_CAP);
+    } else {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Instructions/tick:    %d per thread\n", INSTRUCTIONS_PER_TICK);
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Interpreter:          %s\n", EXEC_INTERPRETER == INTERP_THREADED ? "Threaded (block)" : "Switch");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Decoded instr. cache: %s\n", DECODE_CACHE_ENABLED ? "enabled" : "disabled");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Superinstructions:    %s\n", FUSION_ENABLED && DECODE_CACHE_ENABLED ? "enabled" : "disabled");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "JIT (x86-64):         %s\n", JIT_ENABLED ? "enabled" : "disabled");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Log level:            %s (compiled up to %s)\n",
+               log_level_name(LOG_LEVEL), log_level_name(LOG_COMPILE_LEVEL));
+    if (TLB_ENTRIES > 0) {
+        const char* tlb_policy_names[] = {"Round Robin", "LRU", "Random"};
+        int tlb_ways = (TLB_WAYS > 0 && TLB_WAYS < TLB_ENTRIES) ? TLB_WAYS : TLB_ENTRIES;
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "TLB:                  %d entries, %d-way, %s, %s\n", TLB_ENTRIES, tlb_ways,
+               tlb_policy_names[TLB_POLICY], TLB_ASID_ENABLED ? "ASID-tagged" : "flush on switch");
+    } else {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "TLB:                  disabled\n");
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Scheduler:\n");
+    if (sched_policy == SCHED_POLICY_CFS) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Timeslice:        min %d ticks, target latency %d ticks\n", quantum, CFS_TARGET_LATENCY);
+    } else if (sched_policy == SCHED_POLICY_MLFQ) {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Quantum:          %d ticks at level 0, +%d per level\n", quantum, quantum);
+        if (MLFQ_BOOST_INTERVAL > 0) {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Boost:            every %d ticks\n", MLFQ_BOOST_INTERVAL);
+        } else {
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Boost:            off\n");
+        }
+    } else {
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Quantum:          %d ticks\n", quantum);
+    }
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Policy:           %s\n", scheduler_policy_name(sched_policy));
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Sync mode:        %s\n", sync_names[sched_sync]);
     if (num_timers_global > 0) {
-        printf("Timers:               %d\n", num_timers_global);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "Timers:               %d\n", num_timers_global);
         if (sched_sync == SCHED_SYNC_TIMER) {
-            printf("  - Timer 0:          syncs scheduler (interval: %d ticks)\n", quantum);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Timer 0:          syncs scheduler (interval: %d ticks)\n", quantum);
             if (num_timers_global > 1) {
-                printf("  - Timers 1-%d:       interval: %d ticks (no effect on execution)\n", 
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Timers 1-%d:       interval: %d ticks (no effect on execution)\n", 
                        num_timers_global - 1, timer_interval);
             }
         } else {
-            printf("  - All timers:       interval: %d ticks (no effect on execution)\n", timer_interval);
+            LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - All timers:       interval: %d ticks (no effect on execution)\n", timer_interval);
         }
     }
     // Process generator disabled - info not shown
     // printf("Process gen interval: %d-%d ticks\n", proc_gen_min, proc_gen_max);
     // printf("Process TTL range:    %d-%d ticks\n", proc_ttl_min, proc_ttl_max);
-    printf("Max processes:        %d (queue size limit)\n", ready_queue_size);
-    printf("Machine topology:\n");
-    printf("  - CPUs:             %d\n", num_cpus);
-    printf("  - Cores per CPU:    %d\n", num_cores);
-    printf("  - Threads per core: %d\n", num_threads);
-    printf("  - Total threads:    %d\n", total_threads);
-    printf("  - Usable threads:   %d (limited by max_processes)\n", max_usable_threads);
-    printf("============================\033[0m");
-    printf("\nPress Ctrl+C to exit...\n\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Max processes:        %d (queue size limit)\n", ready_queue_size);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Machine topology:\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - CPUs:             %d\n", num_cpus);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Cores per CPU:    %d\n", num_cores);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Threads per core: %d\n", num_threads);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Total threads:    %d\n", total_threads);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Usable threads:   %d (limited by max_processes)\n", max_usable_threads);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "============================\033[0m");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\nPress Ctrl+C to exit...\n\n");
     
     // Print warnings and info about scheduler creation (if using priority queues)
     if (sched_policy == SCHED_POLICY_PREEMPTIVE_PRIO) {
@@ -604,16 +960,17 @@ int main(int argc, char *argv[]) {
             queue_capacity = 2;
         }
         int total_capacity = queue_capacity * 40;
-        printf("[Scheduler] Created 40 priority queues (capacity %d each, total %d/%d)\n", 
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Scheduler] Created 40 priority queues (capacity %d each, total %d/%d)\n", 
                queue_capacity, total_capacity, ready_queue_size);
     }
     
     // Start scheduler only - ProcessGenerator disabled (using .elf programs only)
     // start_process_generator(proc_gen_global);
+    set_clock_scheduler(scheduler_global);
     start_scheduler(scheduler_global);
+    release_clock();
 
-    printf("\n\033[32m=== Running system ===\033[0m\n");
-    fflush(stdout);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n\033[32m=== Running system ===\033[0m\n");
     
     // Wait for signal using pause() which will be interrupted by SIGINT
     while (running) {
@@ -621,10 +978,10 @@ int main(int argc, char *argv[]) {
     }
     
     // Cleanup
-    printf("\n=== System cleanup and shutdown ===\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "\n=== System cleanup and shutdown ===\n");
     cleanup_system(clk_thread_global, timers_global, num_timers_global);
     free(timers_global);
-    printf("=== System shutdown complete ===\033[0m\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "=== System shutdown complete ===\033[0m\n");
 
     return 0;
 }
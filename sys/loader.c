@@ -1,11 +1,44 @@
 #include "loader.h"
 #include "memory.h"
+#include "log.h"
+#include "clock.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <stdint.h>
 
+// Instructions a program executes from its entry point until it stops.
+// The ISA has no branches, so execution is straight-line: it ends at the
+// first EXIT or unknown opcode (both retire). A program without one runs
+// off its code; the whole code segment is the estimate then. Stores into
+// the code segment can change the real count: it is static
+static uint32_t count_program_instructions(const uint32_t* code, uint32_t code_size, uint32_t entry_word) {
+    for (uint32_t pc = entry_word; pc < code_size; pc++) {
+        uint8_t opcode = (code[pc] >> 28) & 0xF;
+        if (opcode != OP_LD && opcode != OP_ST && opcode != OP_ADD) {
+            return pc - entry_word + 1;
+        }
+    }
+    return code_size > entry_word ? code_size - entry_word : 0;
+}
+
+// TTL from the real cost: ticks to retire every instruction at the slowest rate a
+// hardware thread gets. With a core cap that is its share when every thread of the
+// core is busy, the lowest one the clock gives (kernel.c keeps the cap at or above
+// the threads per core, so it is at least one instruction). 25% margin, minimum 10 ticks
+static uint32_t ttl_from_instructions(uint32_t instructions, int threads_per_core) {
+    uint32_t rate = INSTRUCTIONS_PER_TICK;
+    if (CORE_INSTRUCTION_CAP > 0) {
+        uint32_t share = CORE_INSTRUCTION_CAP / (threads_per_core > 0 ? threads_per_core : 1);
+        if (share < 1) share = 1;
+        if (share < rate) rate = share;
+    }
+    uint32_t ticks = (instructions + rate - 1) / rate;
+    uint32_t ttl = ticks + ticks / 4;
+    return ttl < 10 ? 10 : ttl;
+}
+
 // Create a new loader
 Loader* create_loader(PhysicalMemory* pm, ProcessQueue* ready_queue, 
                       Machine* machine, Scheduler* scheduler) {
@@ -22,7 +55,7 @@ Loader* create_loader(PhysicalMemory* pm, ProcessQueue* ready_queue,
     loader->next_pid = 1;
     loader->total_loaded = 0;
     
-    printf("Loader initialized\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Loader initialized\n");
     return loader;
 }
 
@@ -67,7 +100,8 @@ Program* load_program_from_elf(const char* filename) {
     // Default values
     program->header.entry_point = 0;
     program->header.priority = 0;  // Will be set later based on program size
-    program->header.ttl = 50;  // Will be set later based on program size
+    program->header.ttl = 50;  // Will be set from the instruction count and the machine
+    program->header.instruction_count = 0;  // Will be set once the code is read
     program->header.text_address = 0;  // Will be set from .text directive
     program->header.data_address = 0;  // Will be set from .data directive
     
@@ -123,18 +157,6 @@ Program* load_program_from_elf(const char* filename) {
     srand((unsigned int)time(NULL) ^ (unsigned int)(uintptr_t)file ^ seed_counter++ ^ program->header.code_size);
     program->header.priority = MIN_PRIORITY + (rand() % NUM_PRIORITY_LEVELS);
     
-    // Calculate realistic TTL based on code size
-    // Estimate: ~2-3 ticks per instruction on average, with some margin
-    // For small programs: minimum 10 ticks, maximum 100 ticks
-    int estimated_ttl = program->header.code_size * 3;
-    if (estimated_ttl < 10) estimated_ttl = 10;
-    if (estimated_ttl > 100) estimated_ttl = 100;
-    program->header.ttl = estimated_ttl;
-    
-    printf("[Loader] Program '%s': code_size=%u words, priority=%d, TTL=%u ticks\n",
-           program->header.program_name, program->header.code_size, 
-           program->header.priority, program->header.ttl);
-    
     // Allocate one contiguous segment for the entire program
     // This makes it easier to load into virtual memory
     uint32_t total_size = program->header.code_size + program->header.data_size;
@@ -197,7 +219,16 @@ Program* load_program_from_elf(const char* filename) {
     
     free(full_program);
     
-    printf("[Loader] ELF Program '%s' loaded: CODE=%u words @0x%06X, DATA=%u words @0x%06X\n",
+    // Real cost of the program (the TTL is derived from it when the process is created)
+    program->header.instruction_count = count_program_instructions(program->code_segment,
+                                                                    program->header.code_size,
+                                                                    program->header.entry_point / WORD_SIZE);
+    
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Loader] Program '%s': code_size=%u words, %u instructions, priority=%d\n",
+           program->header.program_name, program->header.code_size, program->header.instruction_count,
+           program->header.priority);
+    
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Loader] ELF Program '%s' loaded: CODE=%u words @0x%06X, DATA=%u words @0x%06X\n",
            program->header.program_name, 
            program->header.code_size, text_addr,
            program->header.data_size, data_addr);
@@ -237,8 +268,11 @@ PCB* create_process_from_program(Loader* loader, Program* program) {
     }
     
     // Set process attributes
+    program->header.ttl = ttl_from_instructions(program->header.instruction_count,
+                                                loader->machine ? loader->machine->threads_per_core : 1);
     set_pcb_priority(pcb, program->header.priority);
     set_pcb_ttl(pcb, program->header.ttl);
+    pcb->total_instructions = program->header.instruction_count;
     
     // Calculate the total memory span needed
     // .text and .data contain WORD offsets from the .elf file
@@ -252,7 +286,7 @@ PCB* create_process_from_program(Loader* loader, Program* program) {
     uint32_t total_bytes = total_words * WORD_SIZE;
     uint32_t total_pages = calculate_pages_needed(total_bytes);
     
-    printf("[Loader] Process %d: Memory layout - CODE: words 0x%X-0x%X, DATA: words 0x%X-0x%X, Total: %u pages\n", 
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Loader] Process %d: Memory layout - CODE: words 0x%X-0x%X, DATA: words 0x%X-0x%X, Total: %u pages\n", 
            pcb->pid, code_start_word, code_end_word-1, data_start_word, data_end_word-1, total_pages);
     
     // Create page table in kernel space
@@ -326,7 +360,7 @@ PCB* create_process_from_program(Loader* loader, Program* program) {
     }
     
     loader->total_loaded++;
-    printf("[Loader] Process %d created: '%s' (priority=%d, ttl=%d, pages=%u)\n",
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Loader] Process %d created: '%s' (priority=%d, ttl=%d, pages=%u)\n",
            pcb->pid, program->header.program_name, 
            pcb->priority, pcb->ttl, total_pages);
     
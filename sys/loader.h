@@ -23,7 +23,8 @@ typedef struct {
     uint32_t data_address;   // Virtual address where .data section starts (in bytes)
     uint32_t entry_point;    // Entry point (virtual address relative to code segment)
     uint32_t priority;       // Process priority
-    uint32_t ttl;            // Time to live
+    uint32_t ttl;            // Time to live (from instruction_count and the machine)
+    uint32_t instruction_count;  // Instructions executed until EXIT (static: the ISA has no branches)
 } ProgramHeader;
 
 // Program structure (loaded from file)
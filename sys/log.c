@@ -0,0 +1,243 @@
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+// Runtime log level (LOG_LEVEL_INSTR by default: same output as always)
+int LOG_LEVEL = LOG_LEVEL_INSTR;
+
+// Lock-free ring between the producers (clock, scheduler, timers, workers...)
+// and the writer thread. Bounded MPMC queue with one sequence number per cell:
+// producers claim a position with a CAS on ring_head, only the writer moves ring_tail.
+#define LOG_RING_SIZE 16384  // Power of two
+
+typedef struct {
+    size_t seq;
+    LogRecord record;
+} LogCell;
+
+static LogCell* ring = NULL;
+static size_t ring_head = 0;
+static size_t ring_tail = 0;
+static volatile int writer_running = 0;
+static volatile int writer_shutdown = 0;
+static pthread_t writer_thread;
+
+// Records of the calling host thread go here instead of the ring (parallel workers)
+static __thread LogBuffer* log_capture = NULL;
+
+// Format one record on 'out'
+static void log_write_record(FILE* out, const LogRecord* record) {
+    if (record->fmt) {
+        const uint32_t* a = record->data.args;
+        fprintf(out, record->fmt, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]);
+    } else {
+        fputs(record->data.text, out);
+    }
+}
+
+// Returns 1 if the record was queued, 0 if the ring is full
+static int ring_push(const LogRecord* record) {
+    size_t pos = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+    while (1) {
+        LogCell* cell = &ring[pos & (LOG_RING_SIZE - 1)];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        long dif = (long)seq - (long)pos;
+        if (dif == 0) {
+            if (__atomic_compare_exchange_n(&ring_head, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->record = *record;
+                __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Writer side: returns 1 and copies the oldest record, 0 if there is none ready
+static int ring_pop(LogRecord* record) {
+    LogCell* cell = &ring[ring_tail & (LOG_RING_SIZE - 1)];
+    size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+    if (seq != ring_tail + 1) return 0;
+    *record = cell->record;
+    __atomic_store_n(&cell->seq, ring_tail + LOG_RING_SIZE, __ATOMIC_RELEASE);
+    ring_tail++;
+    return 1;
+}
+
+// Hand a record to the writer (or write it now if there is no writer)
+static void log_emit(const LogRecord* record) {
+    if (log_capture) {
+        LogBuffer* buffer = log_capture;
+        if (buffer->count == buffer->capacity) {
+            size_t capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+            LogRecord* records = realloc(buffer->records, capacity * sizeof(LogRecord));
+            if (!records) return;
+            buffer->records = records;
+            buffer->capacity = capacity;
+        }
+        buffer->records[buffer->count++] = *record;
+        return;
+    }
+
+    if (!writer_running) {
+        log_write_record(stdout, record);
+        return;
+    }
+
+    // Ring full: the writer is behind, wait for it rather than losing the record
+    while (!ring_push(record)) {
+        sched_yield();
+    }
+}
+
+// Background writer: formats the records and flushes stdout whenever it catches up
+static void* log_writer_function(void* arg) {
+    (void)arg; // Unused parameter
+    LogRecord record;
+    struct timespec idle = {0, 1000000};  // 1 ms
+
+    while (1) {
+        if (ring_pop(&record)) {
+            log_write_record(stdout, &record);
+            continue;
+        }
+        fflush(stdout);
+        if (__atomic_load_n(&writer_shutdown, __ATOMIC_ACQUIRE)) {
+            // Producers are gone: write what is left and stop
+            while (ring_pop(&record)) {
+                log_write_record(stdout, &record);
+            }
+            fflush(stdout);
+            break;
+        }
+        nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+// Start the writer thread. Returns 0 on success, -1 on error (records stay synchronous)
+int log_start(void) {
+    if (writer_running) return 0;
+
+    ring = calloc(LOG_RING_SIZE, sizeof(LogCell));
+    if (!ring) return -1;
+    for (size_t i = 0; i < LOG_RING_SIZE; i++) {
+        ring[i].seq = i;
+    }
+    ring_head = 0;
+    ring_tail = 0;
+    writer_shutdown = 0;
+
+    // Everything already written synchronously goes out before the writer's records
+    fflush(stdout);
+
+    int ret = pthread_create(&writer_thread, NULL, log_writer_function, NULL);
+    if (ret != 0) {
+        fprintf(stderr, "Error creating log writer thread: %s\n", strerror(ret));
+        free(ring);
+        ring = NULL;
+        return -1;
+    }
+    writer_running = 1;
+    return 0;
+}
+
+// Stop the writer once every producer thread has stopped
+void log_stop(void) {
+    if (!writer_running) return;
+
+    __atomic_store_n(&writer_shutdown, 1, __ATOMIC_RELEASE);
+    pthread_join(writer_thread, NULL);
+    writer_running = 0;
+    free(ring);
+    ring = NULL;
+}
+
+// Queue a deferred record: the format is only applied by the writer
+void log_event(const char* fmt, const uint32_t* args) {
+    LogRecord record;
+    record.fmt = fmt;
+    memcpy(record.data.args, args, sizeof(record.data.args));
+    log_emit(&record);
+}
+
+// Queue formatted text (split in several records if it does not fit in one)
+void log_printf(const char* fmt, ...) {
+    char buf[1024];
+    char* text = buf;
+    va_list ap;
+
+    va_start(ap, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (len < 0) return;
+
+    if ((size_t)len >= sizeof(buf)) {
+        text = malloc(len + 1);
+        if (!text) return;
+        va_start(ap, fmt);
+        vsnprintf(text, len + 1, fmt, ap);
+        va_end(ap);
+    }
+
+    LogRecord record;
+    record.fmt = NULL;
+    for (int off = 0; off < len; off += LOG_TEXT_SIZE - 1) {
+        int chunk = len - off < LOG_TEXT_SIZE - 1 ? len - off : LOG_TEXT_SIZE - 1;
+        memcpy(record.data.text, text + off, chunk);
+        record.data.text[chunk] = '\0';
+        log_emit(&record);
+    }
+
+    if (text != buf) free(text);
+}
+
+// Redirect the records of the calling host thread (NULL = back to the ring)
+void log_set_capture(LogBuffer* buffer) {
+    log_capture = buffer;
+}
+
+// Emit the captured records of another thread, in capture order
+void log_replay(LogBuffer* buffer) {
+    for (size_t i = 0; i < buffer->count; i++) {
+        log_emit(&buffer->records[i]);
+    }
+    buffer->count = 0;
+}
+
+// Free the records of a capture buffer
+void log_buffer_destroy(LogBuffer* buffer) {
+    if (buffer) {
+        free(buffer->records);
+        buffer->records = NULL;
+        buffer->count = 0;
+        buffer->capacity = 0;
+    }
+}
+
+static const char* log_level_names[] = {"off", "summary", "tick", "instr"};
+
+// Parse a level name or number. Returns the level, -1 if invalid
+int log_parse_level(const char* name) {
+    for (int level = LOG_LEVEL_OFF; level <= LOG_LEVEL_INSTR; level++) {
+        if (strcasecmp(name, log_level_names[level]) == 0) return level;
+    }
+    if (name[0] >= '0' && name[0] <= '3' && name[1] == '\0') return name[0] - '0';
+    return -1;
+}
+
+// Name of a log level
+const char* log_level_name(int level) {
+    if (level < LOG_LEVEL_OFF || level > LOG_LEVEL_INSTR) return "unknown";
+    return log_level_names[level];
+}
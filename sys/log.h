@@ -0,0 +1,68 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Log levels: each level includes the ones below it
+#define LOG_LEVEL_OFF     0  // Nothing on stdout (errors still go to stderr)
+#define LOG_LEVEL_SUMMARY 1  // Configuration, process completion and final statistics
+#define LOG_LEVEL_TICK    2  // Clock ticks, TTLs, scheduler and timer events
+#define LOG_LEVEL_INSTR   3  // Every executed instruction (default)
+
+// Highest level compiled in (make LOG_COMPILE_LEVEL=1 removes tick/instruction logging)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INSTR
+#endif
+
+// Runtime level (set from the command line)
+extern int LOG_LEVEL;
+
+#define LOG_ENABLED(level) ((level) <= LOG_COMPILE_LEVEL && (level) <= LOG_LEVEL)
+
+#define LOG_MAX_ARGS  8
+#define LOG_TEXT_SIZE 120
+
+// One log record. Hot paths store a format string literal and its integer
+// arguments: formatting happens later on the writer thread.
+// Other records carry text already formatted by the producer.
+typedef struct {
+    const char* fmt;  // Deferred format (integer conversions only), NULL = text record
+    union {
+        uint32_t args[LOG_MAX_ARGS];
+        char text[LOG_TEXT_SIZE];
+    } data;
+} LogRecord;
+
+// Records of one host thread kept aside and replayed later in a fixed order
+typedef struct {
+    LogRecord* records;
+    size_t count;
+    size_t capacity;
+} LogBuffer;
+
+// Deferred record: LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X\n", pc).
+// No formatting and no syscalls in the caller; compiled out above LOG_COMPILE_LEVEL.
+#define LOG_EVENT(level, fmt, ...) \
+    do { \
+        if (LOG_ENABLED(level)) log_event(fmt, (const uint32_t[LOG_MAX_ARGS]){ __VA_ARGS__ }); \
+    } while (0)
+
+// Formatted record (any printf conversion), for paths that are not per tick/instruction
+#define LOG_PRINTF(level, ...) \
+    do { \
+        if (LOG_ENABLED(level)) log_printf(__VA_ARGS__); \
+    } while (0)
+
+// Function declarations
+int log_start(void);   // Start the writer thread (before it, records are written synchronously)
+void log_stop(void);   // Drain the ring, stop the writer and flush stdout
+void log_event(const char* fmt, const uint32_t* args);
+void log_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void log_set_capture(LogBuffer* buffer);  // Records of the calling thread go to buffer (NULL = ring)
+void log_replay(LogBuffer* buffer);       // Emit the captured records in order and empty the buffer
+void log_buffer_destroy(LogBuffer* buffer);
+int log_parse_level(const char* name);    // "off"/"summary"/"tick"/"instr" or 0-3, -1 if invalid
+const char* log_level_name(int level);
+
+#endif // LOG_H
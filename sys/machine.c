@@ -1,27 +1,32 @@
 #include "machine.h"
 #include "memory.h"
+#include "log.h"
 #include <stdlib.h>
 #include <stdio.h>
 
+// Interpreter used by the clock (INTERP_THREADED by default)
+int EXEC_INTERPRETER = INTERP_THREADED;
+
+// Decoded instruction cache switch (1 = fetch/decode through the per-frame cache)
+int DECODE_CACHE_ENABLED = 1;
+
+// Superinstruction switch (1 = LD/LD/ADD/ST groups run as one fused operation)
+int FUSION_ENABLED = 1;
+
 // Create a new core with given capacity for kernel threads
 Core* create_core(int num_kernel_threads) {
+    if (num_kernel_threads < 1 || num_kernel_threads > MAX_HW_THREADS_PER_CORE) return NULL;
+    
     Core* core = malloc(sizeof(Core));
     if (!core) return NULL;
     
     core->num_kernel_threads = num_kernel_threads;
     core->current_pcb_count = 0;
-    
-    // Legacy PCB array (kept for compatibility)
-    core->pcbs = malloc(sizeof(PCB) * num_kernel_threads);
-    if (!core->pcbs) {
-        free(core);
-        return NULL;
-    }
+    core->free_mask = num_kernel_threads == 64 ? ~0ULL : (1ULL << num_kernel_threads) - 1;
     
     // Initialize hardware threads
     core->hw_threads = malloc(sizeof(HardwareThread) * num_kernel_threads);
     if (!core->hw_threads) {
-        free(core->pcbs);
         free(core);
         return NULL;
     }
@@ -39,15 +44,19 @@ Core* create_core(int num_kernel_threads) {
         
         core->hw_threads[i].mmu.page_table_base = NULL;
         core->hw_threads[i].mmu.enabled = 0;
+        page_cache_reset(&core->hw_threads[i].fetch_page);
+        page_cache_reset(&core->hw_threads[i].data_page);
         core->hw_threads[i].pcb = NULL;
         
-        // Initialize TLB
-        for (int j = 0; j < TLB_SIZE; j++) {
-            core->hw_threads[i].tlb.entries[j].virtual_page = 0;
-            core->hw_threads[i].tlb.entries[j].physical_frame = 0;
-            core->hw_threads[i].tlb.entries[j].valid = 0;
+        // Initialize TLB (geometry from the command line)
+        if (tlb_init(&core->hw_threads[i].tlb) != 0) {
+            for (int j = 0; j < i; j++) {
+                tlb_destroy(&core->hw_threads[j].tlb);
+            }
+            free(core->hw_threads);
+            free(core);
+            return NULL;
         }
-        core->hw_threads[i].tlb.next_replace = 0;
     }
     
     return core;
@@ -90,11 +99,29 @@ Machine* create_machine(int num_cpus, int num_cores, int num_kernel_threads) {
     if (!machine) return NULL;
     
     machine->num_CPUs = num_cpus;
+    machine->cores_per_cpu = num_cores;
+    machine->threads_per_core = num_kernel_threads;
+    machine->running_count = 0;
+    machine->running_heap = malloc(sizeof(RunningPriority) * num_cpus * num_cores * num_kernel_threads);
+    machine->running_pos = malloc(sizeof(int) * num_cpus * num_cores * num_kernel_threads);
+    machine->free_slots = num_cpus * num_cores * num_kernel_threads;
+    machine->free_cores = calloc((num_cpus * num_cores + 63) / 64, sizeof(uint64_t));
     machine->cpus = malloc(sizeof(CPU) * num_cpus);
-    if (!machine->cpus) {
+    if (!machine->cpus || !machine->running_heap || !machine->running_pos || !machine->free_cores) {
+        free(machine->cpus);
+        free(machine->running_heap);
+        free(machine->running_pos);
+        free(machine->free_cores);
         free(machine);
         return NULL;
     }
+    for (int i = 0; i < num_cpus * num_cores * num_kernel_threads; i++) {
+        machine->running_pos[i] = -1;
+    }
+    for (int c = 0; c < num_cpus * num_cores; c++) {
+        machine->free_cores[c / 64] |= 1ULL << (c % 64);
+    }
+    pthread_mutex_init(&machine->running_lock, NULL);
     
     // Initialize each CPU
     for (int i = 0; i < num_cpus; i++) {
@@ -104,11 +131,14 @@ Machine* create_machine(int num_cpus, int num_cores, int num_kernel_threads) {
             // Cleanup on failure
             for (int j = 0; j < i; j++) {
                 for (int k = 0; k < machine->cpus[j].num_cores; k++) {
-                    free(machine->cpus[j].cores[k].pcbs);
+                    destroy_core(&machine->cpus[j].cores[k]);
                 }
                 free(machine->cpus[j].cores);
             }
             free(machine->cpus);
+            free(machine->running_heap);
+            free(machine->running_pos);
+            free(machine->free_cores);
             free(machine);
             return NULL;
         }
@@ -129,6 +159,9 @@ Machine* create_machine(int num_cpus, int num_cores, int num_kernel_threads) {
                     free(machine->cpus[k].cores);
                 }
                 free(machine->cpus);
+                free(machine->running_heap);
+                free(machine->running_pos);
+                free(machine->free_cores);
                 free(machine);
                 return NULL;
             }
@@ -143,7 +176,9 @@ Machine* create_machine(int num_cpus, int num_cores, int num_kernel_threads) {
 // Destroy core and free memory
 void destroy_core(Core* core) {
     if (core) {
-        free(core->pcbs);
+        for (int i = 0; i < core->num_kernel_threads; i++) {
+            tlb_destroy(&core->hw_threads[i].tlb);
+        }
         free(core->hw_threads);
         // Note: don't free 'core' itself when it's part of an array
     }
@@ -153,7 +188,7 @@ void destroy_core(Core* core) {
 void destroy_cpu(CPU* cpu) {
     if (cpu) {
         for (int i = 0; i < cpu->num_cores; i++) {
-            free(cpu->cores[i].pcbs);
+            destroy_core(&cpu->cores[i]);
         }
         free(cpu->cores);
         free(cpu);
@@ -164,88 +199,198 @@ void destroy_cpu(CPU* cpu) {
 void destroy_machine(Machine* machine) {
     if (machine) {
         for (int i = 0; i < machine->num_CPUs; i++) {
-            // Free cores' PCB arrays
+            // Free cores' hardware threads and TLBs
             for (int j = 0; j < machine->cpus[i].num_cores; j++) {
-                free(machine->cpus[i].cores[j].pcbs);
+                destroy_core(&machine->cpus[i].cores[j]);
             }
             free(machine->cpus[i].cores);
         }
         free(machine->cpus);
+        free(machine->running_heap);
+        free(machine->running_pos);
+        free(machine->free_cores);
+        pthread_mutex_destroy(&machine->running_lock);
         free(machine);
     }
 }
 
+// Does running entry a go before entry b? (lower priority first, then the first slot)
+static int running_before(const RunningPriority* a, const RunningPriority* b) {
+    if (a->priority != b->priority) return a->priority > b->priority;
+    return a->slot < b->slot;
+}
+
+// Put an entry at heap position pos
+static void running_heap_set(Machine* machine, int pos, RunningPriority entry) {
+    machine->running_heap[pos] = entry;
+    machine->running_pos[entry.slot] = pos;
+}
+
+// Restore the heap property from position pos upwards
+static void running_heap_sift_up(Machine* machine, int pos) {
+    RunningPriority entry = machine->running_heap[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!running_before(&entry, &machine->running_heap[parent])) break;
+        running_heap_set(machine, pos, machine->running_heap[parent]);
+        pos = parent;
+    }
+    running_heap_set(machine, pos, entry);
+}
+
+// Restore the heap property from position pos downwards
+static void running_heap_sift_down(Machine* machine, int pos) {
+    RunningPriority entry = machine->running_heap[pos];
+    while (1) {
+        int child = 2 * pos + 1;
+        if (child >= machine->running_count) break;
+        if (child + 1 < machine->running_count &&
+            running_before(&machine->running_heap[child + 1], &machine->running_heap[child])) child++;
+        if (!running_before(&machine->running_heap[child], &entry)) break;
+        running_heap_set(machine, pos, machine->running_heap[child]);
+        pos = child;
+    }
+    running_heap_set(machine, pos, entry);
+}
+
+// A process with this priority started running on a slot
+static void running_heap_insert(Machine* machine, int slot, int priority) {
+    RunningPriority entry = {priority, slot};
+    running_heap_set(machine, machine->running_count++, entry);
+    running_heap_sift_up(machine, machine->running_count - 1);
+}
+
+// The process of a slot stopped running
+static void running_heap_remove(Machine* machine, int slot) {
+    int pos = machine->running_pos[slot];
+    if (pos < 0) return;
+    
+    machine->running_pos[slot] = -1;
+    machine->running_count--;
+    if (pos == machine->running_count) return;
+    
+    // The last entry fills the hole
+    RunningPriority last = machine->running_heap[machine->running_count];
+    running_heap_set(machine, pos, last);
+    running_heap_sift_up(machine, pos);
+    running_heap_sift_down(machine, machine->running_pos[last.slot]);
+}
+
+// Slot number of a hardware thread
+static int hw_thread_slot(Machine* machine, int cpu_idx, int core_idx, int thread_idx) {
+    return (cpu_idx * machine->cores_per_cpu + core_idx) * machine->threads_per_core + thread_idx;
+}
+
+// Mark hardware thread k of a core as busy (1) or free (0) in both indexes
+static void set_slot_busy(Machine* machine, int core_id, Core* core, int k, int busy) {
+    if (busy) {
+        core->free_mask &= ~(1ULL << k);
+        core->current_pcb_count++;
+        __sync_fetch_and_sub(&machine->free_slots, 1);
+    } else {
+        core->free_mask |= 1ULL << k;
+        core->current_pcb_count--;
+        __sync_fetch_and_add(&machine->free_slots, 1);
+    }
+    // The core is only changed by its owner; other cores share the bitmap word
+    if (core->free_mask) {
+        __sync_fetch_and_or(&machine->free_cores[core_id / 64], 1ULL << (core_id % 64));
+    } else {
+        __sync_fetch_and_and(&machine->free_cores[core_id / 64], ~(1ULL << (core_id % 64)));
+    }
+}
+
 // Check if any CPU can execute a process (has at least one core with available space)
 int can_cpu_execute_process(Machine* machine) {
-    if (!machine) return 0;
+    return machine && machine->free_slots > 0;
+}
+
+// Core by machine-wide index (cpu * cores_per_cpu + core)
+Core* get_machine_core(Machine* machine, int core_id) {
+    return &machine->cpus[core_id / machine->cores_per_cpu].cores[core_id % machine->cores_per_cpu];
+}
+
+// Load a process on free hardware thread hw_idx of a core
+static void load_hw_thread(Machine* machine, int core_id, int hw_idx, PCB* pcb) {
+    Core* core = get_machine_core(machine, core_id);
+    
+    // Assign PCB pointer to hardware thread (use the actual PCB from parameter)
+    HardwareThread* hw_thread = &core->hw_threads[hw_idx];
+    hw_thread->pcb = pcb;  // Point to the ORIGINAL PCB, not a copy
+    
+    // Initialize hardware thread context from PCB
+    hw_thread->PTBR = pcb->mm.pgb;  // Set page table base register from original PCB
+    
+    // Initialize PC only if this is a NEW process (state != RUNNING)
+    // If the process is being reassigned after quantum expired, preserve PC
+    if (pcb->context.pc == 0 && pcb->state != RUNNING) {
+        hw_thread->PC = 0;  // Start at virtual address 0 (code segment start)
+    } else {
+        hw_thread->PC = pcb->context.pc;  // Restore saved PC
+    }
     
-    for (int i = 0; i < machine->num_CPUs; i++) {
-        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
-            Core* core = &machine->cpus[i].cores[j];
-            if (core->current_pcb_count < core->num_kernel_threads) {
-                return 1;  // Found a core with available space
-            }
-        }
+    // Restore IR from PCB context
+    hw_thread->IR = pcb->context.instruction;
+    
+    // Restore registers from PCB context
+    for (int r = 0; r < 16; r++) {
+        hw_thread->registers[r] = pcb->context.registers[r];
     }
     
-    return 0;  // No core has available space
+    // Enable MMU
+    hw_thread->mmu.page_table_base = hw_thread->PTBR;
+    hw_thread->mmu.enabled = 1;
+    page_cache_reset(&hw_thread->fetch_page);
+    page_cache_reset(&hw_thread->data_page);
+    
+    // Switch the TLB to the address space of the process (ASID = PID)
+    tlb_switch_asid(&hw_thread->tlb, (uint32_t)pcb->pid);
+    
+    set_slot_busy(machine, core_id, core, hw_idx, 1);
+    pcb->last_slot = core_id * machine->threads_per_core + hw_idx;
+    pthread_mutex_lock(&machine->running_lock);
+    running_heap_insert(machine, pcb->last_slot, pcb->priority);
+    pthread_mutex_unlock(&machine->running_lock);
 }
 
-// Assign a process to the first available kernel thread in any core
-// Returns 1 if successful, 0 if no space available
+// Assign a process to a free kernel thread: the one it last ran on if it is free
+// (its TLB entries may still be there), otherwise the first free one of the first
+// core with room. Returns 1 if successful, 0 if no space available
 int assign_process_to_core(Machine* machine, PCB* pcb) {
-    if (!machine || !pcb) return 0;
-    
-    for (int i = 0; i < machine->num_CPUs; i++) {
-        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
-            Core* core = &machine->cpus[i].cores[j];
-            if (core->current_pcb_count < core->num_kernel_threads) {
-                // Found available space - assign the process
-                int hw_idx = core->current_pcb_count;
-                
-                // Store pointer to PCB in legacy array (DO NOT COPY - just keep the pointer)
-                core->pcbs[hw_idx] = *pcb;  // Keep a copy for compatibility
-                
-                // Assign PCB pointer to hardware thread (use the actual PCB from parameter)
-                HardwareThread* hw_thread = &core->hw_threads[hw_idx];
-                hw_thread->pcb = pcb;  // Point to the ORIGINAL PCB, not a copy
-                
-                // Initialize hardware thread context from PCB
-                hw_thread->PTBR = pcb->mm.pgb;  // Set page table base register from original PCB
-                
-                // Initialize PC only if this is a NEW process (state != RUNNING)
-                // If the process is being reassigned after quantum expired, preserve PC
-                if (pcb->context.pc == 0 && pcb->state != RUNNING) {
-                    hw_thread->PC = 0;  // Start at virtual address 0 (code segment start)
-                } else {
-                    hw_thread->PC = pcb->context.pc;  // Restore saved PC
-                }
-                
-                // Restore IR from PCB context
-                hw_thread->IR = pcb->context.instruction;
-                
-                // Restore registers from PCB context
-                for (int r = 0; r < 16; r++) {
-                    hw_thread->registers[r] = pcb->context.registers[r];
-                }
-                
-                // Enable MMU
-                hw_thread->mmu.page_table_base = hw_thread->PTBR;
-                hw_thread->mmu.enabled = 1;
-                
-                // Clear TLB
-                for (int t = 0; t < TLB_SIZE; t++) {
-                    hw_thread->tlb.entries[t].valid = 0;
-                }
-                hw_thread->tlb.next_replace = 0;
-                
-                core->current_pcb_count++;
-                return 1;
-            }
+    if (!machine || !pcb || machine->free_slots == 0) return 0;
+    
+    if (pcb->last_slot >= 0) {
+        int last_core = pcb->last_slot / machine->threads_per_core;
+        int last_thread = pcb->last_slot % machine->threads_per_core;
+        if (get_machine_core(machine, last_core)->free_mask & (1ULL << last_thread)) {
+            load_hw_thread(machine, last_core, last_thread, pcb);
+            return 1;
         }
     }
     
-    return 0;  // No space available
+    int core_id = -1;
+    for (int w = 0; core_id < 0; w++) {
+        if (machine->free_cores[w]) core_id = w * 64 + __builtin_ctzll(machine->free_cores[w]);
+    }
+    load_hw_thread(machine, core_id, __builtin_ctzll(get_machine_core(machine, core_id)->free_mask), pcb);
+    return 1;
+}
+
+// Assign a process to a free kernel thread of one core (its last one there if free).
+// Returns 1 if successful, 0 if the core is full
+int assign_process_to_core_id(Machine* machine, PCB* pcb, int core_id) {
+    if (!machine || !pcb) return 0;
+    
+    Core* core = get_machine_core(machine, core_id);
+    if (!core->free_mask) return 0;
+    
+    int hw_idx = __builtin_ctzll(core->free_mask);
+    if (pcb->last_slot >= 0 && pcb->last_slot / machine->threads_per_core == core_id &&
+        (core->free_mask & (1ULL << (pcb->last_slot % machine->threads_per_core)))) {
+        hw_idx = pcb->last_slot % machine->threads_per_core;
+    }
+    load_hw_thread(machine, core_id, hw_idx, pcb);
+    return 1;
 }
 
 // Remove a completed or expired process from cores
@@ -256,38 +401,12 @@ int remove_process_from_core(Machine* machine, int pid) {
     for (int i = 0; i < machine->num_CPUs; i++) {
         for (int j = 0; j < machine->cpus[i].num_cores; j++) {
             Core* core = &machine->cpus[i].cores[j];
-            for (int k = 0; k < core->current_pcb_count; k++) {
+            for (int k = 0; k < core->num_kernel_threads; k++) {
                 HardwareThread* hw_thread = &core->hw_threads[k];
                 if (hw_thread->pcb && hw_thread->pcb->pid == pid) {
-                    // Found the process - clean up hardware thread
                     // Note: We DON'T free the PCB here - it may be requeued
                     // The scheduler or final cleanup will free it
-                    hw_thread->pcb = NULL;
-                    hw_thread->PTBR = NULL;
-                    hw_thread->PC = 0;
-                    hw_thread->IR = 0;
-                    hw_thread->mmu.page_table_base = NULL;
-                    hw_thread->mmu.enabled = 0;
-                    
-                    // Shift remaining processes
-                    for (int l = k; l < core->current_pcb_count - 1; l++) {
-                        core->hw_threads[l].pcb = core->hw_threads[l + 1].pcb;
-                        core->hw_threads[l].PTBR = core->hw_threads[l + 1].PTBR;
-                        core->hw_threads[l].PC = core->hw_threads[l + 1].PC;
-                        core->hw_threads[l].IR = core->hw_threads[l + 1].IR;
-                        // Keep copying other hardware thread state as needed
-                        
-                        // Also update legacy pcbs array
-                        if (core->hw_threads[l].pcb) {
-                            core->pcbs[l] = *core->hw_threads[l].pcb;
-                        }
-                    }
-                    
-                    // Clear the last hardware thread
-                    core->hw_threads[core->current_pcb_count - 1].pcb = NULL;
-                    core->hw_threads[core->current_pcb_count - 1].PTBR = NULL;
-                    
-                    core->current_pcb_count--;
+                    release_hw_thread(machine, i, j, k);
                     return 1;
                 }
             }
@@ -297,30 +416,99 @@ int remove_process_from_core(Machine* machine, int pid) {
     return 0;  // Process not found
 }
 
+// Save the execution context of a hardware thread in its PCB
+void save_hw_thread_context(HardwareThread* hw_thread, PCB* pcb) {
+    pcb->context.pc = hw_thread->PC;
+    pcb->context.instruction = hw_thread->IR;
+    for (int r = 0; r < 16; r++) {
+        pcb->context.registers[r] = hw_thread->registers[r];
+    }
+}
+
+// Free a hardware thread (process completed, expired or preempted).
+// Slots never move: the other processes of the core keep their thread and TLB.
+// Returns the PCB that was running there (not freed, its context is not saved)
+PCB* release_hw_thread(Machine* machine, int cpu_idx, int core_idx, int thread_idx) {
+    Core* core = &machine->cpus[cpu_idx].cores[core_idx];
+    HardwareThread* hw_thread = &core->hw_threads[thread_idx];
+    PCB* pcb = hw_thread->pcb;
+    if (!pcb) return NULL;
+    
+    pthread_mutex_lock(&machine->running_lock);
+    running_heap_remove(machine, hw_thread_slot(machine, cpu_idx, core_idx, thread_idx));
+    pthread_mutex_unlock(&machine->running_lock);
+    
+    hw_thread->pcb = NULL;
+    hw_thread->PTBR = NULL;
+    hw_thread->PC = 0;
+    hw_thread->IR = 0;
+    hw_thread->mmu.page_table_base = NULL;
+    hw_thread->mmu.enabled = 0;
+    
+    set_slot_busy(machine, cpu_idx * machine->cores_per_cpu + core_idx, core, thread_idx, 0);
+    return pcb;
+}
+
+// Lowest priority running (highest value) and its hardware thread, from the
+// top of the running heap. Returns MAX_PRIORITY+1 if nothing is executing
+int get_lowest_priority_executing(Machine* machine, int* cpu_idx, int* core_idx, int* thread_idx) {
+    *cpu_idx = -1;
+    *core_idx = -1;
+    *thread_idx = -1;
+    if (!machine || machine->running_count == 0) return MAX_PRIORITY + 1;
+    
+    int slot = machine->running_heap[0].slot;
+    *thread_idx = slot % machine->threads_per_core;
+    *core_idx = (slot / machine->threads_per_core) % machine->cores_per_cpu;
+    *cpu_idx = slot / (machine->threads_per_core * machine->cores_per_cpu);
+    return machine->running_heap[0].priority;
+}
+
 // Count total number of processes currently executing in machine
 int count_executing_processes(Machine* machine) {
     if (!machine) return 0;
+    return machine->num_CPUs * machine->cores_per_cpu * machine->threads_per_core - machine->free_slots;
+}
+
+// Invalidate the TLB entries of an address space on every hardware thread
+// (the process has finished and its page table is gone)
+void invalidate_tlb_asid(Machine* machine, uint32_t asid) {
+    if (!machine) return;
     
-    int count = 0;
     for (int i = 0; i < machine->num_CPUs; i++) {
         for (int j = 0; j < machine->cpus[i].num_cores; j++) {
-            count += machine->cpus[i].cores[j].current_pcb_count;
+            Core* core = &machine->cpus[i].cores[j];
+            for (int k = 0; k < core->num_kernel_threads; k++) {
+                tlb_invalidate_asid(&core->hw_threads[k].tlb, asid);
+            }
         }
     }
+}
+
+// Add up the TLB counters of every hardware thread
+void get_tlb_statistics(Machine* machine, unsigned long* hits, unsigned long* misses,
+                        unsigned long* flushes_avoided) {
+    *hits = 0;
+    *misses = 0;
+    *flushes_avoided = 0;
+    if (!machine) return;
     
-    return count;
+    for (int i = 0; i < machine->num_CPUs; i++) {
+        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
+            Core* core = &machine->cpus[i].cores[j];
+            for (int k = 0; k < core->num_kernel_threads; k++) {
+                *hits += core->hw_threads[k].tlb.hits;
+                *misses += core->hw_threads[k].tlb.misses;
+                *flushes_avoided += core->hw_threads[k].tlb.flushes_avoided;
+            }
+        }
+    }
 }
 
 // ============================================================================
 // INSTRUCTION EXECUTION - FASE 2
 // ============================================================================
 
-// Instruction opcodes
-#define OP_LD   0x0  // Load
-#define OP_ST   0x1  // Store
-#define OP_ADD  0x2  // Add
-#define OP_EXIT 0xF  // Exit
-
 // Helper: Extract opcode (upper 4 bits)
 static inline uint8_t extract_opcode(uint32_t instruction) {
     return (instruction >> 28) & 0xF;
@@ -346,44 +534,159 @@ static inline uint8_t extract_reg_src2(uint32_t instruction) {
     return (instruction >> 16) & 0xF;
 }
 
+// Decode an instruction word into its fields.
+// If page_table is given, LD/ST data addresses are translated once here (decoded cache);
+// otherwise they are translated by the MMU on every execution.
+void decode_instruction(DecodedInstruction* decoded, uint32_t instruction,
+                        PageTableEntry* page_table, TLB* tlb) {
+    decoded->raw = instruction;
+    decoded->opcode = extract_opcode(instruction);
+    decoded->reg = extract_reg(instruction);
+    decoded->src1 = extract_reg_src1(instruction);
+    decoded->src2 = extract_reg_src2(instruction);
+    decoded->address = extract_address(instruction);
+    decoded->data_address = 0;
+    decoded->translated = 0;
+    decoded->valid = 1;
+    decoded->fused = 0;
+    decoded->host_code = NULL;
+    decoded->host_length = 0;
+    
+    if (page_table && (decoded->opcode == OP_LD || decoded->opcode == OP_ST)) {
+        uint32_t virtual_page = decoded->address >> PAGE_OFFSET_BITS;
+        uint32_t frame;
+        // Pages not present are left untranslated: the MMU reports the fault at execution
+        if (mmu_translate_page(page_table, tlb, virtual_page, &frame) == 0) {
+            uint32_t offset = decoded->address & ((1 << PAGE_OFFSET_BITS) - 1);
+            decoded->data_address = ((frame << PAGE_OFFSET_BITS) | offset) / WORD_SIZE;
+            decoded->translated = 1;
+        }
+    }
+}
+
+// Check whether the LD at frame_cache[word] starts a LD/LD/ADD/ST group (the idiom
+// prometheus emits for every statement). The followers are decoded into temporaries and
+// only stored in the cache if the whole group matches, so a failed attempt does not hide
+// a group starting at the next word. The group must fit in the frame, its LD/ST must be
+// translated and the ST must not write over the group itself.
+static void detect_fused_group(DecodedInstruction* frame_cache, uint32_t frame_base, uint32_t word,
+                               PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb) {
+    static const uint8_t pattern[FUSED_GROUP_LENGTH] = { OP_LD, OP_LD, OP_ADD, OP_ST };
+    DecodedInstruction group[FUSED_GROUP_LENGTH];
+    
+    if (word + FUSED_GROUP_LENGTH > FRAME_WORDS || !frame_cache[word].translated) return;
+    
+    group[0] = frame_cache[word];
+    for (int i = 1; i < FUSED_GROUP_LENGTH; i++) {
+        if (frame_cache[word + i].valid) {
+            group[i] = frame_cache[word + i];
+        } else {
+            decode_instruction(&group[i], pm->memory[frame_base + word + i], page_table, tlb);
+        }
+        if (group[i].opcode != pattern[i]) return;
+        if (group[i].opcode != OP_ADD && !group[i].translated) return;
+    }
+    uint32_t st_target = group[FUSED_GROUP_LENGTH - 1].data_address;
+    if (st_target >= frame_base + word && st_target < frame_base + word + FUSED_GROUP_LENGTH) return;
+    
+    for (int i = 1; i < FUSED_GROUP_LENGTH; i++) {
+        if (!frame_cache[word + i].valid) frame_cache[word + i] = group[i];
+        frame_cache[word + i].covered = 1;  // Writes to any member drop the fused flag
+    }
+    frame_cache[word].covered = 1;
+    frame_cache[word].fused = 1;
+}
+
+// Decode frame_cache[word] from memory (cache miss)
+static inline void decode_cached(DecodedInstruction* frame_cache, uint32_t frame_base, uint32_t word,
+                                 PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb) {
+    decode_instruction(&frame_cache[word], pm->memory[frame_base + word], page_table, tlb);
+    if (FUSION_ENABLED && frame_cache[word].opcode == OP_LD) {
+        detect_fused_group(frame_cache, frame_base, word, pm, page_table, tlb);
+    }
+}
+
+// Fetch the instruction at PC through the decoded instruction cache
+// Returns NULL if the code page is not present (the slow path reports the fault)
+static DecodedInstruction* fetch_decoded(HardwareThread* hw_thread, PhysicalMemory* pm,
+                                         PageTableEntry* page_table) {
+    PageCache* code = &hw_thread->fetch_page;
+    if (!page_cache_hit(code, hw_thread->PC) &&
+        page_cache_fill(code, pm, page_table, &hw_thread->tlb, hw_thread->PC) != 0) {
+        return NULL;
+    }
+    uint32_t frame = code->frame_number;
+    
+    DecodedInstruction* frame_cache = get_decoded_frame(pm, frame);
+    if (!frame_cache) return NULL;
+    
+    uint32_t offset_words = (hw_thread->PC & PAGE_OFFSET_MASK) / WORD_SIZE;
+    DecodedInstruction* decoded = &frame_cache[offset_words];
+    if (!decoded->valid) {
+        // Miss: fetch from memory and decode once
+        decode_cached(frame_cache, frame * FRAME_WORDS, offset_words, pm, page_table, &hw_thread->tlb);
+    }
+    return decoded;
+}
+
 // Instruction: LD (Load) - Opcode 0
 // Format: 0RAAAAAA (R = register, A = address)
 // Action: R = [Address]
-static void execute_ld(HardwareThread* hw_thread, PhysicalMemory* pm, uint32_t instruction) {
-    uint8_t reg = extract_reg(instruction);
-    uint32_t address = extract_address(instruction);
+// Returns 0, or -1 on a page fault
+static int execute_ld(HardwareThread* hw_thread, PhysicalMemory* pm, const DecodedInstruction* decoded) {
+    uint8_t reg = decoded->reg;
+    uint32_t address = decoded->address;
+    uint32_t value;
+    int status = 0;
     
-    // Use MMU to read from virtual address
     PageTableEntry* page_table = (PageTableEntry*)hw_thread->PTBR;
-    uint32_t value = mmu_read_word(pm, page_table, address);
+    
+    if (decoded->translated) {
+        page_table[address >> PAGE_OFFSET_BITS].accessed = 1;
+        value = pm->memory[decoded->data_address];
+    } else {
+        // Use MMU to read from virtual address (last data page first)
+        status = mmu_read_cached(pm, page_table, &hw_thread->tlb, &hw_thread->data_page, address, &value);
+    }
     
     hw_thread->registers[reg] = value;
     
-    printf("  [LD] r%u = [0x%06X] = 0x%08X\n", reg, address, value);
+    LOG_EVENT(LOG_LEVEL_INSTR, "  [LD] r%u = [0x%06X] = 0x%08X\n", reg, address, value);
+    return status;
 }
 
 // Instruction: ST (Store) - Opcode 1
 // Format: 1RAAAAAA (R = register, A = address)
 // Action: [Address] = R
-static void execute_st(HardwareThread* hw_thread, PhysicalMemory* pm, uint32_t instruction) {
-    uint8_t reg = extract_reg(instruction);
-    uint32_t address = extract_address(instruction);
+// Returns 0, or -1 on a page fault
+static int execute_st(HardwareThread* hw_thread, PhysicalMemory* pm, const DecodedInstruction* decoded) {
+    uint8_t reg = decoded->reg;
+    uint32_t address = decoded->address;
     uint32_t value = hw_thread->registers[reg];
-    
-    // Use MMU to write to virtual address
     PageTableEntry* page_table = (PageTableEntry*)hw_thread->PTBR;
-    mmu_write_word(pm, page_table, address, value);
+    int status = 0;
+    
+    if (decoded->translated) {
+        uint32_t virtual_page = address >> PAGE_OFFSET_BITS;
+        page_table[virtual_page].dirty = 1;
+        page_table[virtual_page].accessed = 1;
+        write_word(pm, decoded->data_address, value);  // Also invalidates decoded copies
+    } else {
+        // Use MMU to write to virtual address (last data page first)
+        status = mmu_write_cached(pm, page_table, &hw_thread->tlb, &hw_thread->data_page, address, value);
+    }
     
-    printf("  [ST] [0x%06X] = r%u = 0x%08X\n", address, reg, value);
+    LOG_EVENT(LOG_LEVEL_INSTR, "  [ST] [0x%06X] = r%u = 0x%08X\n", address, reg, value);
+    return status;
 }
 
 // Instruction: ADD - Opcode 2
 // Format: 2RXY---- (R = dest, X = src1, Y = src2)
 // Action: R = X + Y (signed integers, complement a 2)
-static void execute_add(HardwareThread* hw_thread, uint32_t instruction) {
-    uint8_t reg_dest = extract_reg(instruction);
-    uint8_t reg_src1 = extract_reg_src1(instruction);
-    uint8_t reg_src2 = extract_reg_src2(instruction);
+static void execute_add(HardwareThread* hw_thread, const DecodedInstruction* decoded) {
+    uint8_t reg_dest = decoded->reg;
+    uint8_t reg_src1 = decoded->src1;
+    uint8_t reg_src2 = decoded->src2;
     
     // Perform signed addition
     int32_t val1 = (int32_t)hw_thread->registers[reg_src1];
@@ -392,16 +695,15 @@ static void execute_add(HardwareThread* hw_thread, uint32_t instruction) {
     
     hw_thread->registers[reg_dest] = (uint32_t)result;
     
-    printf("  [ADD] r%u = r%u + r%u = %d + %d = %d (0x%08X)\n",
-           reg_dest, reg_src1, reg_src2, val1, val2, result, (uint32_t)result);
+    LOG_EVENT(LOG_LEVEL_INSTR, "  [ADD] r%u = r%u + r%u = %d + %d = %d (0x%08X)\n",
+              reg_dest, reg_src1, reg_src2, val1, val2, result, (uint32_t)result);
 }
 
 // Instruction: EXIT - Opcode F
 // Format: F-------
 // Action: Halt the hardware thread
 static void execute_exit(HardwareThread* hw_thread) {
-    printf("   [EXIT] Process PID=%d TERMINATED\n", hw_thread->pcb ? hw_thread->pcb->pid : -1);
-    fflush(stdout);
+    LOG_EVENT(LOG_LEVEL_INSTR, "   [EXIT] Process PID=%d TERMINATED\n", hw_thread->pcb ? hw_thread->pcb->pid : -1);
     
     // Mark process as terminated
     if (hw_thread->pcb) {
@@ -414,55 +716,83 @@ static void execute_exit(HardwareThread* hw_thread) {
     // The scheduler will detect TERMINATED state and remove the process
 }
 
+// Superinstruction: LD, LD, ADD, ST of a fused group in one dispatch.
+// Same effects and traces as running the four instructions one by one.
+static void execute_fused_group(HardwareThread* hw_thread, PhysicalMemory* pm, const DecodedInstruction* group) {
+    execute_ld(hw_thread, pm, &group[0]);
+    LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: Instruction=0x%08X ", hw_thread->PC + 4, group[1].raw);
+    execute_ld(hw_thread, pm, &group[1]);
+    LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: Instruction=0x%08X ", hw_thread->PC + 8, group[2].raw);
+    execute_add(hw_thread, &group[2]);
+    LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: Instruction=0x%08X ", hw_thread->PC + 12, group[3].raw);
+    execute_st(hw_thread, pm, &group[3]);
+    
+    hw_thread->IR = group[3].raw;
+    hw_thread->PC += 4 * FUSED_GROUP_LENGTH;
+}
+
 // Main instruction cycle: Fetch -> Decode -> Execute -> Update PC
-void execute_instruction_cycle(HardwareThread* hw_thread, PhysicalMemory* pm) {
+// Returns 0 on success, -1 on error or if the instruction hit a page fault
+int execute_instruction_cycle(HardwareThread* hw_thread, PhysicalMemory* pm) {
     if (!hw_thread || !pm) {
         fprintf(stderr, "Error: Invalid hardware thread or physical memory\n");
-        return;
+        return -1;
     }
     
     // Skip if no PCB assigned
     if (!hw_thread->pcb) {
-        return;
+        return 0;
     }
     
     // Skip if process is terminated - don't execute any more instructions
     if (hw_thread->pcb->state == TERMINATED) {
-        return;
+        return 0;
     }
     
     // Check if PTBR is valid
     if (!hw_thread->PTBR) {
         fprintf(stderr, "Error: PTBR not initialized for hardware thread\n");
-        return;
+        return -1;
     }
     
     PageTableEntry* page_table = (PageTableEntry*)hw_thread->PTBR;
-    
-    // === FETCH ===
-    // Fetch instruction from memory using PC (virtual address)
-    uint32_t instruction = mmu_read_word(pm, page_table, hw_thread->PC);
+    int fault = 0;
+    
+    // === FETCH + DECODE ===
+    // Decoded cache hit: no memory read and no field extraction
+    DecodedInstruction uncached;
+    DecodedInstruction* decoded = DECODE_CACHE_ENABLED ? fetch_decoded(hw_thread, pm, page_table) : NULL;
+    if (!decoded) {
+        // Fetch instruction from memory using PC (virtual address), last code page first
+        uint32_t fetched;
+        if (mmu_read_cached(pm, page_table, &hw_thread->tlb, &hw_thread->fetch_page,
+                            hw_thread->PC, &fetched) != 0) {
+            fault = 1;
+        }
+        decode_instruction(&uncached, fetched, NULL, NULL);
+        decoded = &uncached;
+    }
+    uint32_t instruction = decoded->raw;
     hw_thread->IR = instruction;
     
-    printf("PC=0x%06X: Instruction=0x%08X ", hw_thread->PC, instruction);
+    LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: Instruction=0x%08X ", hw_thread->PC, instruction);
     
-    // === DECODE ===
-    uint8_t opcode = extract_opcode(instruction);
+    uint8_t opcode = decoded->opcode;
     
     // === EXECUTE ===
     switch (opcode) {
         case OP_LD:
-            execute_ld(hw_thread, pm, instruction);
+            if (execute_ld(hw_thread, pm, decoded) != 0) fault = 1;
             hw_thread->PC += 4;  // Move to next instruction
             break;
             
         case OP_ST:
-            execute_st(hw_thread, pm, instruction);
+            if (execute_st(hw_thread, pm, decoded) != 0) fault = 1;
             hw_thread->PC += 4;
             break;
             
         case OP_ADD:
-            execute_add(hw_thread, instruction);
+            execute_add(hw_thread, decoded);
             hw_thread->PC += 4;
             break;
             
@@ -475,7 +805,128 @@ void execute_instruction_cycle(HardwareThread* hw_thread, PhysicalMemory* pm) {
             fprintf(stderr, "Error: Unknown opcode 0x%X in instruction 0x%08X\n", 
                     opcode, instruction);
             hw_thread->pcb->state = TERMINATED;
-            break;
+            return -1;
     }
+    
+    return fault ? -1 : 0;
 }
 
+
+// Threaded-code interpreter: executes up to max_instructions of the process on hw_thread.
+// Validation is done once per block; each instruction is one decoded cache access and
+// a computed goto to its handler. Stops early on EXIT, on an invalid instruction or
+// after an instruction that hit a page fault.
+// Returns the number of instructions executed.
+int execute_instruction_block(HardwareThread* hw_thread, PhysicalMemory* pm, int max_instructions) {
+    if (!hw_thread || !pm) {
+        fprintf(stderr, "Error: Invalid hardware thread or physical memory\n");
+        return 0;
+    }
+    if (!hw_thread->pcb || hw_thread->pcb->state == TERMINATED || max_instructions <= 0) {
+        return 0;
+    }
+    if (!hw_thread->PTBR) {
+        fprintf(stderr, "Error: PTBR not initialized for hardware thread\n");
+        return 0;
+    }
+    
+    int executed = 0;
+    
+    // Without decoded instructions there is nothing to thread: step the classic cycle
+    if (!DECODE_CACHE_ENABLED) {
+        while (executed < max_instructions && hw_thread->pcb->state != TERMINATED) {
+            int status = execute_instruction_cycle(hw_thread, pm);
+            executed++;
+            if (status < 0) break;
+        }
+        return executed;
+    }
+    
+    // Handlers indexed by opcode (0x3-0xE are not defined by the ISA)
+    static const void* dispatch[16] = {
+        &&op_ld, &&op_st, &&op_add, &&op_invalid,
+        &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+        &&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+        &&op_invalid, &&op_invalid, &&op_invalid, &&op_exit
+    };
+    
+    PageTableEntry* page_table = (PageTableEntry*)hw_thread->PTBR;
+    TLB* tlb = &hw_thread->tlb;
+    PageCache* code = &hw_thread->fetch_page;
+    DecodedInstruction* frame_cache = NULL;   // Decoded array of the current code page
+    uint32_t frame_base = 0;                  // Physical word address of the current code page
+    uint32_t code_page = UINT32_MAX;          // Virtual page of frame_cache
+    DecodedInstruction* decoded;
+    int status;
+    
+    // Fetch + decode the instruction at PC and jump to its handler
+    #define DISPATCH_NEXT() do {                                                          \
+        if (executed >= max_instructions) goto block_done;                               \
+        uint32_t page = hw_thread->PC >> PAGE_OFFSET_BITS;                                \
+        if (page != code_page) {                                                          \
+            if (!page_cache_hit(code, hw_thread->PC) &&                                   \
+                page_cache_fill(code, pm, page_table, tlb, hw_thread->PC) != 0) {         \
+                goto slow_path;                                                           \
+            }                                                                             \
+            frame_cache = get_decoded_frame(pm, code->frame_number);                      \
+            if (!frame_cache) goto slow_path;                                             \
+            frame_base = code->frame_number * FRAME_WORDS;                                \
+            code_page = page;                                                             \
+        }                                                                                 \
+        uint32_t word = (hw_thread->PC & PAGE_OFFSET_MASK) / WORD_SIZE;                   \
+        decoded = &frame_cache[word];                                                     \
+        if (!decoded->valid) {                                                            \
+            decode_cached(frame_cache, frame_base, word, pm, page_table, tlb);            \
+        }                                                                                 \
+        hw_thread->IR = decoded->raw;                                                     \
+        LOG_EVENT(LOG_LEVEL_INSTR, "PC=0x%06X: Instruction=0x%08X ",                      \
+                  hw_thread->PC, decoded->raw);                                           \
+        executed++;                                                                       \
+        goto *dispatch[decoded->opcode];                                                  \
+    } while (0)
+    
+    DISPATCH_NEXT();
+    
+op_ld:
+    // Fused group only if the whole group fits in the budget (ticks stay per instruction)
+    if (decoded->fused && executed + FUSED_GROUP_LENGTH - 1 <= max_instructions) {
+        execute_fused_group(hw_thread, pm, decoded);
+        executed += FUSED_GROUP_LENGTH - 1;
+        DISPATCH_NEXT();
+    }
+    status = execute_ld(hw_thread, pm, decoded);
+    hw_thread->PC += 4;
+    if (status != 0) goto block_done;  // Data page not present: page fault
+    DISPATCH_NEXT();
+    
+op_st:
+    status = execute_st(hw_thread, pm, decoded);
+    hw_thread->PC += 4;
+    if (status != 0) goto block_done;
+    DISPATCH_NEXT();
+    
+op_add:
+    execute_add(hw_thread, decoded);
+    hw_thread->PC += 4;
+    DISPATCH_NEXT();
+    
+op_exit:
+    execute_exit(hw_thread);
+    goto block_done;
+    
+op_invalid:
+    fprintf(stderr, "Error: Unknown opcode 0x%X in instruction 0x%08X\n",
+            decoded->opcode, decoded->raw);
+    hw_thread->pcb->state = TERMINATED;
+    goto block_done;
+    
+slow_path:
+    // Code page not present: the classic cycle goes through the MMU and reports the fault
+    execute_instruction_cycle(hw_thread, pm);
+    executed++;
+    goto block_done;
+    
+block_done:
+    #undef DISPATCH_NEXT
+    return executed;
+}
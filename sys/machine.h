@@ -2,30 +2,19 @@
 #define MACHINE_H
 
 #include "process.h"
+#include "memory.h"
 #include <stdint.h>
 
 // Machine -> CPU -> Core -> Hardware Thread (PCBs + registers)
 
+#define MAX_HW_THREADS_PER_CORE 64  // Bits of the per-core free mask
+
 // Forward declaration
 struct Machine;
 struct CPU;
 struct Core;
 struct HardwareThread;
 
-// TLB Entry structure
-#define TLB_SIZE 16  // Number of entries in TLB
-typedef struct {
-    uint32_t virtual_page;   // Virtual page number
-    uint32_t physical_frame; // Physical frame number
-    uint8_t valid;           // Valid bit (1 = entry is valid)
-} TLBEntry;
-
-// Translation Lookaside Buffer (TLB)
-typedef struct {
-    TLBEntry entries[TLB_SIZE];
-    int next_replace;  // Index for simple round-robin replacement
-} TLB;
-
 // Memory Management Unit (MMU) - simulated
 typedef struct {
     void* page_table_base;  // Pointer to page table base (PTBR content)
@@ -43,6 +32,8 @@ typedef struct {
     // Memory management hardware
     MMU mmu;                // Memory Management Unit
     TLB tlb;                // Translation Lookaside Buffer
+    PageCache fetch_page;   // Last code page (instruction fetch fast path)
+    PageCache data_page;    // Last data page (LD/ST fast path)
     
     // Associated PCB (if any)
     PCB* pcb;               // Pointer to currently executing PCB (NULL if idle)
@@ -51,8 +42,8 @@ typedef struct {
 // Core: contains hardware threads
 typedef struct Core {
     int num_kernel_threads;     // Maximum number of hardware threads
-    int current_pcb_count;       // Current number of PCBs in this core (DEPRECATED - use hw_threads)
-    PCB* pcbs;                   // Legacy PCB array (DEPRECATED)
+    int current_pcb_count;       // Busy hardware threads
+    uint64_t free_mask;          // Bit k set while hw_threads[k] is free (slots never move)
     HardwareThread* hw_threads;  // Array of hardware threads
 } Core;
 
@@ -62,10 +53,30 @@ typedef struct CPU {
     Core* cores;
 } CPU;
 
+// Priority running on one hardware thread (entry of the running heap)
+typedef struct {
+    int priority;
+    int slot;  // (cpu * cores_per_cpu + core) * threads_per_core + thread
+} RunningPriority;
+
 // Machine: contains multiple CPUs
 typedef struct Machine {
     int num_CPUs;
     CPU* cpus;
+    int cores_per_cpu;
+    int threads_per_core;
+    
+    // Free-slot index: bit c set while core c (cpu * cores_per_cpu + core) has a free thread.
+    // Updated atomically: with per-core run queues the exec workers load processes
+    uint64_t* free_cores;
+    int free_slots;    // Free hardware threads in the whole machine
+    
+    // Indexed max-heap of the priorities running on the hardware threads:
+    // the top is the preemption victim (lowest priority, first thread on ties)
+    RunningPriority* running_heap;
+    int running_count;
+    int* running_pos;  // Heap position of each slot, -1 if the thread is idle
+    pthread_mutex_t running_lock;  // Protects the heap (loads from the exec workers)
 } Machine;
 
 // Function declarations
@@ -75,13 +86,38 @@ Machine* create_machine(int num_cpus, int num_cores, int num_kernel_threads);
 void destroy_core(Core* core);
 void destroy_cpu(CPU* cpu);
 void destroy_machine(Machine* machine);
-int can_cpu_execute_process(Machine* machine);  // Returns 1 if any core has space, 0 otherwise
-int assign_process_to_core(Machine* machine, PCB* pcb);  // Assign process to first available core
+int can_cpu_execute_process(Machine* machine);  // Returns 1 if any core has space, 0 otherwise (O(1))
+int assign_process_to_core(Machine* machine, PCB* pcb);  // Its last hardware thread if free, else the first free one
+int assign_process_to_core_id(Machine* machine, PCB* pcb, int core_id);  // On one core (cpu * cores_per_cpu + core)
+Core* get_machine_core(Machine* machine, int core_id);
 int remove_process_from_core(Machine* machine, int pid);  // Remove process from core by PID
+void save_hw_thread_context(HardwareThread* hw_thread, PCB* pcb);  // PC, IR and registers to the PCB
+PCB* release_hw_thread(Machine* machine, int cpu_idx, int core_idx, int thread_idx);  // Returns its PCB
+int get_lowest_priority_executing(Machine* machine, int* cpu_idx, int* core_idx, int* thread_idx);  // O(1)
 int count_executing_processes(Machine* machine);  // Count total executing processes
+void invalidate_tlb_asid(Machine* machine, uint32_t asid);  // Drop an address space from every TLB
+void get_tlb_statistics(Machine* machine, unsigned long* hits, unsigned long* misses,
+                        unsigned long* flushes_avoided);  // All hardware threads
 
 // Instruction execution
-#include "memory.h"
-void execute_instruction_cycle(HardwareThread* hw_thread, PhysicalMemory* pm);
+#include <stdio.h>
+
+// Instruction opcodes
+#define OP_LD   0x0  // Load
+#define OP_ST   0x1  // Store
+#define OP_ADD  0x2  // Add
+#define OP_EXIT 0xF  // Exit
+
+#define INTERP_SWITCH   0  // One fetch-decode-execute cycle per call (switch dispatch)
+#define INTERP_THREADED 1  // Block interpreter with computed-goto dispatch (default)
+extern int EXEC_INTERPRETER;
+extern int DECODE_CACHE_ENABLED;  // 1 = use the decoded instruction cache (default)
+
+// Superinstruction fusion of LD/LD/ADD/ST groups (1 = enabled)
+extern int FUSION_ENABLED;
+int execute_instruction_cycle(HardwareThread* hw_thread, PhysicalMemory* pm);
+int execute_instruction_block(HardwareThread* hw_thread, PhysicalMemory* pm, int max_instructions);
+void decode_instruction(DecodedInstruction* decoded, uint32_t instruction,
+                        PageTableEntry* page_table, TLB* tlb);
 
 #endif // MACHINE_H
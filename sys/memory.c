@@ -1,4 +1,5 @@
 #include "memory.h"
+#include "log.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -28,6 +29,16 @@ PhysicalMemory* create_physical_memory() {
         return NULL;
     }
     
+    // Decoded instruction cache: frame arrays are allocated when code is first fetched
+    pm->decoded_frames = calloc(TOTAL_FRAMES, sizeof(DecodedInstruction*));
+    if (!pm->decoded_frames) {
+        fprintf(stderr, "Error: Failed to allocate decoded instruction cache\n");
+        free(pm->frame_bitmap);
+        free(pm->memory);
+        free(pm);
+        return NULL;
+    }
+    
     // Initialize memory boundaries
     pm->kernel_space_end = KERNEL_SPACE_WORDS;
     pm->user_space_start = KERNEL_SPACE_WORDS;
@@ -40,17 +51,17 @@ PhysicalMemory* create_physical_memory() {
     }
     pm->total_allocated_frames = KERNEL_FRAMES;
     
-    printf("Physical Memory initialized:\n");
-    printf("  Total size: %u bytes (%u words)\n", PHYSICAL_MEMORY_SIZE, TOTAL_WORDS);
-    printf("  Kernel space: %u bytes (%u words, %u frames)\n", 
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "Physical Memory initialized:\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Total size: %u bytes (%u words)\n", PHYSICAL_MEMORY_SIZE, TOTAL_WORDS);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Kernel space: %u bytes (%u words, %u frames)\n", 
            KERNEL_SPACE_SIZE, KERNEL_SPACE_WORDS, KERNEL_FRAMES);
-    printf("  User space: %u bytes (%u words, %u frames)\n", 
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  User space: %u bytes (%u words, %u frames)\n", 
            PHYSICAL_MEMORY_SIZE - KERNEL_SPACE_SIZE, 
            TOTAL_WORDS - KERNEL_SPACE_WORDS,
            USER_FRAMES);
-    printf("  Address bus: %d bits\n", ADDRESS_BUS_BITS);
-    printf("  Word size: %d bytes\n", WORD_SIZE);
-    printf("  Page/Frame size: %d bytes\n", PAGE_SIZE);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Address bus: %d bits\n", ADDRESS_BUS_BITS);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Word size: %d bytes\n", WORD_SIZE);
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "  Page/Frame size: %d bytes\n", PAGE_SIZE);
     
     return pm;
 }
@@ -58,6 +69,10 @@ PhysicalMemory* create_physical_memory() {
 // Destroy physical memory and free resources
 void destroy_physical_memory(PhysicalMemory* pm) {
     if (pm) {
+        for (uint32_t i = 0; i < TOTAL_FRAMES; i++) {
+            free(pm->decoded_frames[i]);
+        }
+        free(pm->decoded_frames);
         free(pm->memory);
         free(pm->frame_bitmap);
         free(pm);
@@ -91,6 +106,7 @@ void free_frame(PhysicalMemory* pm, uint32_t frame_number) {
     if (pm->frame_bitmap[frame_number] == 1) {
         pm->frame_bitmap[frame_number] = 0;  // Mark as free
         pm->total_allocated_frames--;
+        invalidate_decoded_frame(pm, frame_number);  // Next owner brings different code
     }
 }
 
@@ -138,6 +154,79 @@ void write_word(PhysicalMemory* pm, uint32_t address, uint32_t value) {
         return;
     }
     pm->memory[address] = value;
+    
+    // Self-modifying code (or a reloaded frame): drop the decoded copy of this word
+    if (pm->decoded_frames[address / FRAME_WORDS]) {
+        invalidate_decoded_word(pm, address);
+    }
+}
+
+// Owner of the host code translations (NULL while the JIT is off)
+void (*host_code_release)(void* host_code) = NULL;
+
+// Drop the host code translation covering decoded[word]: unlink it from every word
+// it covers and hand it back to the JIT
+static void drop_host_code(DecodedInstruction* decoded, uint32_t word) {
+    void* host_code = decoded[word].host_code;
+    uint32_t start = word;
+    while (start > 0 && decoded[start - 1].host_code == host_code) start--;
+    uint32_t end = word + decoded[word].host_length;
+    for (uint32_t w = start; w < end; w++) {
+        decoded[w].host_code = NULL;
+    }
+    if (host_code_release) host_code_release(host_code);
+}
+
+// Drop the decoded copy of a word that has been written, and any fused group or
+// host code translation that includes it
+void invalidate_decoded_word(PhysicalMemory* pm, uint32_t address) {
+    DecodedInstruction* decoded = pm->decoded_frames[address / FRAME_WORDS];
+    if (!decoded) return;
+    
+    uint32_t word = address % FRAME_WORDS;
+    decoded[word].valid = 0;
+    
+    if (decoded[word].host_code) {
+        drop_host_code(decoded, word);
+    }
+    
+    if (decoded[word].covered) {
+        // Groups never cross a frame: look back at most FUSED_GROUP_LENGTH words
+        uint32_t first = (word >= FUSED_GROUP_LENGTH - 1) ? word - (FUSED_GROUP_LENGTH - 1) : 0;
+        for (uint32_t start = first; start <= word; start++) {
+            if (decoded[start].fused && start + FUSED_GROUP_LENGTH > word) {
+                decoded[start].fused = 0;
+            }
+        }
+        decoded[word].covered = 0;
+    }
+}
+
+// Get the decoded instruction array of a frame, allocating it on first use
+// Returns NULL if the frame is invalid or memory is exhausted
+DecodedInstruction* get_decoded_frame(PhysicalMemory* pm, uint32_t frame_number) {
+    if (!pm || frame_number >= TOTAL_FRAMES) return NULL;
+    
+    if (!pm->decoded_frames[frame_number]) {
+        pm->decoded_frames[frame_number] = calloc(FRAME_WORDS, sizeof(DecodedInstruction));
+    }
+    return pm->decoded_frames[frame_number];
+}
+
+// Drop every decoded instruction of a frame
+void invalidate_decoded_frame(PhysicalMemory* pm, uint32_t frame_number) {
+    if (!pm || frame_number >= TOTAL_FRAMES) return;
+    
+    DecodedInstruction* decoded = pm->decoded_frames[frame_number];
+    if (!decoded) return;
+    
+    // Hand its translations back to the JIT
+    for (uint32_t word = 0; word < FRAME_WORDS; word++) {
+        if (decoded[word].host_code) drop_host_code(decoded, word);
+    }
+    
+    free(decoded);
+    pm->decoded_frames[frame_number] = NULL;
 }
 
 // Create a page table for a process
@@ -182,10 +271,50 @@ void destroy_page_table(PhysicalMemory* pm, PageTableEntry* page_table, uint32_t
     }
 }
 
+// MMU: Translate a virtual page to its frame, looking in the TLB before the page table
+// Returns 0 on success, -1 if the page is not present
+int mmu_translate_page(PageTableEntry* page_table, TLB* tlb, uint32_t virtual_page,
+                       uint32_t* physical_frame) {
+    if (tlb && tlb_lookup(tlb, virtual_page, physical_frame)) {
+        return 0;  // TLB hit: no page table access
+    }
+    
+    // TLB miss: page table walk
+    if (!page_table[virtual_page].present) {
+        return -1;
+    }
+    *physical_frame = page_table[virtual_page].frame_number;
+    if (tlb) {
+        tlb_insert(tlb, virtual_page, *physical_frame);
+    }
+    return 0;
+}
+
+// Fill a last page cache with the translation of virtual_address (TLB, then page table)
+// Returns 0 on success, -1 if the page is not present (the cache is left empty)
+int page_cache_fill(PageCache* cache, PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
+                    uint32_t virtual_address) {
+    cache->host_frame = NULL;
+    if (!pm || !page_table) return -1;
+    
+    uint32_t virtual_page = virtual_address >> PAGE_OFFSET_BITS;
+    uint32_t frame_number;
+    if (mmu_translate_page(page_table, tlb, virtual_page, &frame_number) != 0) {
+        return -1;
+    }
+    
+    cache->virtual_page = virtual_page;
+    cache->frame_number = frame_number;
+    cache->pte = &page_table[virtual_page];
+    cache->pte->accessed = 1;
+    cache->host_frame = &pm->memory[frame_number * FRAME_WORDS];
+    return 0;
+}
+
 // MMU: Translate virtual address to physical address
 // Virtual Address = [Virtual Page Number | Offset]
 // Physical Address = [Physical Frame Number | Offset]
-uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_table, 
+uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                                        uint32_t virtual_address) {
     if (!pm || !page_table) {
         fprintf(stderr, "Error: Invalid PM or page table in MMU translation\n");
@@ -196,15 +325,13 @@ uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_
     uint32_t offset = virtual_address & ((1 << PAGE_OFFSET_BITS) - 1);  // Lower 12 bits
     uint32_t virtual_page = virtual_address >> PAGE_OFFSET_BITS;         // Upper bits
     
-    // Check if page is present in memory
-    if (!page_table[virtual_page].present) {
+    // Get physical frame number from the TLB or the page table
+    uint32_t frame_number;
+    if (mmu_translate_page(page_table, tlb, virtual_page, &frame_number) != 0) {
         fprintf(stderr, "Error: Page fault! Virtual page %u not present in memory\n", virtual_page);
         return 0;
     }
     
-    // Get physical frame number from page table
-    uint32_t frame_number = page_table[virtual_page].frame_number;
-    
     // Calculate physical address (in bytes)
     uint32_t physical_address_bytes = (frame_number << PAGE_OFFSET_BITS) | offset;
     
@@ -215,7 +342,7 @@ uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_
 }
 
 // MMU: Read a word using virtual address
-uint32_t mmu_read_word(PhysicalMemory* pm, PageTableEntry* page_table, 
+uint32_t mmu_read_word(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                        uint32_t virtual_address) {
     if (!pm || !page_table) {
         fprintf(stderr, "Error: Invalid PM or page table in MMU read\n");
@@ -223,14 +350,14 @@ uint32_t mmu_read_word(PhysicalMemory* pm, PageTableEntry* page_table,
     }
     
     // Translate virtual address to physical address
-    uint32_t physical_address = translate_virtual_to_physical(pm, page_table, virtual_address);
+    uint32_t physical_address = translate_virtual_to_physical(pm, page_table, tlb, virtual_address);
     
     // Read from physical memory
     return read_word(pm, physical_address);
 }
 
 // MMU: Write a word using virtual address
-void mmu_write_word(PhysicalMemory* pm, PageTableEntry* page_table, 
+void mmu_write_word(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                     uint32_t virtual_address, uint32_t value) {
     if (!pm || !page_table) {
         fprintf(stderr, "Error: Invalid PM or page table in MMU write\n");
@@ -238,7 +365,7 @@ void mmu_write_word(PhysicalMemory* pm, PageTableEntry* page_table,
     }
     
     // Translate virtual address to physical address
-    uint32_t physical_address = translate_virtual_to_physical(pm, page_table, virtual_address);
+    uint32_t physical_address = translate_virtual_to_physical(pm, page_table, tlb, virtual_address);
     
     // Extract virtual page number to mark as dirty
     uint32_t virtual_page = virtual_address >> PAGE_OFFSET_BITS;
@@ -2,6 +2,8 @@
 #define MEMORY_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include "tlb.h"
 
 // Physical Memory Configuration
 // 24-bit address bus = 2^24 = 16,777,216 bytes addressable
@@ -26,6 +28,8 @@
 #define TOTAL_FRAMES (PHYSICAL_MEMORY_SIZE / FRAME_SIZE)
 #define KERNEL_FRAMES (KERNEL_SPACE_SIZE / FRAME_SIZE)
 #define USER_FRAMES (TOTAL_FRAMES - KERNEL_FRAMES)
+#define FRAME_WORDS (FRAME_SIZE / WORD_SIZE)  // 1024 words per frame
+#define PAGE_OFFSET_MASK ((1 << PAGE_OFFSET_BITS) - 1)
 
 // Page Table Entry structure
 typedef struct {
@@ -38,10 +42,32 @@ typedef struct {
     uint32_t reserved : 15;      // Reserved for future use
 } PageTableEntry;
 
+// Decoded instruction cache entry (one per word of a frame holding executed code)
+// Filled on first fetch, invalidated by write_word() when the word is overwritten
+typedef struct {
+    uint32_t raw;            // Instruction word as fetched
+    uint32_t address;        // Virtual address field (LD/ST)
+    uint32_t data_address;   // Pre-translated physical word address (valid if translated)
+    uint8_t opcode;
+    uint8_t reg;             // Register field (bits 27-24)
+    uint8_t src1;            // Source register 1 (ADD)
+    uint8_t src2;            // Source register 2 (ADD)
+    uint8_t translated;      // 1 if data_address holds the translation of 'address'
+    uint8_t valid;           // 1 if the entry matches the word in memory
+    uint8_t covered;         // 1 if the word is part of a fused group
+    uint8_t fused;           // 1 if this word starts a fused LD/LD/ADD/ST group
+    uint16_t host_length;    // Instructions of host_code from this word to its end (if not NULL)
+    void* host_code;         // Host code translation covering this word (JIT), NULL if none
+} DecodedInstruction;
+
+#define FUSED_GROUP_LENGTH 4       // LD, LD, ADD, ST
+#define MAX_TRANSLATION_LENGTH 64  // Max instructions in one host code translation
+
 // Physical Memory structure
 typedef struct {
     uint32_t* memory;                    // Array of words (4 bytes each)
     uint8_t* frame_bitmap;               // Bitmap for frame allocation (1 bit per frame)
+    DecodedInstruction** decoded_frames; // Decoded instruction cache per frame (NULL = no code decoded)
     uint32_t kernel_space_end;           // End address of kernel space (in words)
     uint32_t user_space_start;           // Start address of user space (in words)
     uint32_t next_kernel_frame;          // Next available frame in kernel space (for page tables)
@@ -64,16 +90,75 @@ void* allocate_kernel_space(PhysicalMemory* pm, uint32_t size_in_words);
 uint32_t read_word(PhysicalMemory* pm, uint32_t address);
 void write_word(PhysicalMemory* pm, uint32_t address, uint32_t value);
 
+// Decoded instruction cache
+DecodedInstruction* get_decoded_frame(PhysicalMemory* pm, uint32_t frame_number);  // Allocates on first use
+void invalidate_decoded_frame(PhysicalMemory* pm, uint32_t frame_number);
+void invalidate_decoded_word(PhysicalMemory* pm, uint32_t address);  // After a write to 'address'
+extern void (*host_code_release)(void* host_code);  // Called for each dropped translation (set by the JIT)
+
 // Page table management
 PageTableEntry* create_page_table(PhysicalMemory* pm, uint32_t num_pages);
 void destroy_page_table(PhysicalMemory* pm, PageTableEntry* page_table, uint32_t num_pages);
 
-// MMU - Address Translation
-uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_table, 
+// MMU - Address Translation (tlb may be NULL: always walk the page table)
+int mmu_translate_page(PageTableEntry* page_table, TLB* tlb, uint32_t virtual_page,
+                       uint32_t* physical_frame);
+uint32_t translate_virtual_to_physical(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                                        uint32_t virtual_address);
-uint32_t mmu_read_word(PhysicalMemory* pm, PageTableEntry* page_table, 
+uint32_t mmu_read_word(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                        uint32_t virtual_address);
-void mmu_write_word(PhysicalMemory* pm, PageTableEntry* page_table, 
+void mmu_write_word(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
                     uint32_t virtual_address, uint32_t value);
 
+// Last page translation (virtual page -> host pointer to its frame).
+// One per hardware thread and access kind: sequential fetch and accesses to the
+// same data page skip the TLB, the page table and read_word()/write_word() checks.
+typedef struct {
+    uint32_t virtual_page;
+    uint32_t frame_number;
+    uint32_t* host_frame;     // &pm->memory[frame_number * FRAME_WORDS], NULL = empty
+    PageTableEntry* pte;      // Entry of virtual_page (accessed/dirty bits)
+} PageCache;
+
+int page_cache_fill(PageCache* cache, PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
+                    uint32_t virtual_address);  // Slow path, -1 if the page is not present
+
+static inline void page_cache_reset(PageCache* cache) {
+    cache->host_frame = NULL;
+}
+
+static inline int page_cache_hit(const PageCache* cache, uint32_t virtual_address) {
+    return cache->host_frame && (virtual_address >> PAGE_OFFSET_BITS) == cache->virtual_page;
+}
+
+// MMU fast path: read a word. On a page change the slow path refills the cache;
+// a page fault is reported by mmu_read_word(). Returns 0, or -1 on a page fault.
+static inline int mmu_read_cached(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
+                                  PageCache* cache, uint32_t virtual_address, uint32_t* value) {
+    if (!page_cache_hit(cache, virtual_address) &&
+        page_cache_fill(cache, pm, page_table, tlb, virtual_address) != 0) {
+        *value = mmu_read_word(pm, page_table, tlb, virtual_address);
+        return -1;
+    }
+    *value = cache->host_frame[(virtual_address & PAGE_OFFSET_MASK) / WORD_SIZE];
+    return 0;
+}
+
+// MMU fast path: write a word (same rules as mmu_read_cached)
+static inline int mmu_write_cached(PhysicalMemory* pm, PageTableEntry* page_table, TLB* tlb,
+                                   PageCache* cache, uint32_t virtual_address, uint32_t value) {
+    if (!page_cache_hit(cache, virtual_address) &&
+        page_cache_fill(cache, pm, page_table, tlb, virtual_address) != 0) {
+        mmu_write_word(pm, page_table, tlb, virtual_address, value);
+        return -1;
+    }
+    uint32_t word = (virtual_address & PAGE_OFFSET_MASK) / WORD_SIZE;
+    cache->host_frame[word] = value;
+    cache->pte->dirty = 1;
+    if (pm->decoded_frames[cache->frame_number]) {
+        invalidate_decoded_word(pm, cache->frame_number * FRAME_WORDS + word);
+    }
+    return 0;
+}
+
 #endif // MEMORY_H
@@ -1,10 +1,13 @@
 #include "process.h"
 #include "clock.h"
 #include "machine.h"
+#include "log.h"
+#include "event.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
 #include <string.h>
+#include <limits.h>
 
 // ============================================================================
 // PCB Management
@@ -22,6 +25,14 @@ PCB* create_pcb(int pid) {
     pcb->initial_ttl = 0;  // Default initial TTL
     pcb->quantum_counter = 0; // Initialize quantum counter
     pcb->virtual_deadline = 0; // Initialize virtual deadline
+    pcb->last_slot = -1;
+    pcb->arrival_tick = get_current_tick();
+    pcb->mlfq_level = 0;
+    pcb->vruntime = 0;
+    pcb->timeslice = 0;
+    pcb->exec_start = 0;
+    pcb->retired_instructions = 0;
+    pcb->total_instructions = 0;
     
     // Initialize memory management fields
     pcb->mm.code = NULL;
@@ -135,33 +146,57 @@ PCB* dequeue_process(ProcessQueue* pq) {
     return pcb;
 }
 
+// Remove and return the newest process of the queue
+PCB* dequeue_process_tail(ProcessQueue* pq) {
+    if (pq->current_size == 0) {
+        return NULL; // Queue empty
+    }
+    
+    PCB* pcb = pq->queue[pq->rear];
+    pq->rear = (pq->rear - 1 + pq->max_capacity) % pq->max_capacity;
+    pq->current_size--;
+    
+    return pcb;
+}
+
 // ============================================================================
 // Process Generator
 // ============================================================================
 
-// Process generator thread function
+// Process generator thread function. It is a tick barrier participant: it checks in
+// every tick, whether or not it creates a process in it.
 void* process_generator_function(void* arg) {
     ProcessGenerator* pg = (ProcessGenerator*)arg;
     int next_generation_tick = 0;
     int interval;
     int waiting_for_space = 0;  // Flag to track if we're waiting for queue space
     PCB* pending_pcb = NULL;    // PCB waiting to be enqueued
+    int last_tick = pg->registered_tick;
     
     // Seed random number generator with current time + thread ID
     srand(time(NULL) ^ (unsigned long)pthread_self());
     
+    pthread_mutex_lock(&clk_mutex);
     while (pg->running && running) {
-        pthread_mutex_lock(&clk_mutex);
-        
-        // Wait until next generation time
-        while (pg->running && running && clk_counter < next_generation_tick) {
+        // Wait for next clock tick
+        while (pg->running && running && clk_counter == last_tick) {
             pthread_cond_wait(&clk_cond, &clk_mutex);
         }
         
         if (!pg->running || !running) {
-            pthread_mutex_unlock(&clk_mutex);
             break;
         }
+        last_tick = clk_counter;
+        
+        // Not yet the next generation time
+        if (clk_counter < next_generation_tick) {
+            clock_tick_arrive(pg->barrier_id, last_tick);
+            if (TICKLESS_ENABLED) {
+                // Sleep until the clock pops the arrival event
+                last_tick = clock_tick_idle(pg->barrier_id, EVENT_PROCESS_ARRIVAL, &pg->running) - 1;
+            }
+            continue;
+        }
         
         // Calculate current total processes (ready queue + executing + priority queues)
         int executing_count = pg->machine ? count_executing_processes(pg->machine) : 0;
@@ -170,14 +205,13 @@ void* process_generator_function(void* arg) {
         
         // Check if we have space for new process
         if (total_processes >= pg->max_processes) {
-            // No space available
+            // No space available: try again next tick
             if (!waiting_for_space) {
-                printf("[Process Generator] Maximum process limit reached (%d/%d)! Waiting for space...\n",
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Process Generator] Maximum process limit reached (%d/%d)! Waiting for space...\n",
                        total_processes, pg->max_processes);
-                fflush(stdout);
                 waiting_for_space = 1;
             }
-            pthread_mutex_unlock(&clk_mutex);
+            clock_tick_arrive(pg->barrier_id, last_tick);
             continue;
         }
         
@@ -197,9 +231,9 @@ void* process_generator_function(void* arg) {
                 // Set random priority in range [-20, 19]
                 pending_pcb->priority = MIN_PRIORITY + (rand() % NUM_PRIORITY_LEVELS);
             } else {
-                printf("[Process Generator] Failed to allocate PCB for PID=%d\n", new_pid);
+                LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Process Generator] Failed to allocate PCB for PID=%d\n", new_pid);
                 __sync_fetch_and_sub(&pg->next_pid, 1);
-                pthread_mutex_unlock(&clk_mutex);
+                clock_tick_arrive(pg->barrier_id, last_tick);
                 continue;
             }
         }
@@ -209,25 +243,24 @@ void* process_generator_function(void* arg) {
         if (enqueue_result == 0) {
             // Successfully enqueued
             __sync_fetch_and_add(&pg->total_generated, 1);
+            scheduler_notify_work(pg->scheduler);
             
             // If we were waiting, indicate we resumed
             if (waiting_for_space) {
-                printf("[Process Generator] Space available - resuming process generation\n");
-                fflush(stdout);
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Process Generator] Space available - resuming process generation\n");
                 waiting_for_space = 0;
             }
             
             // Print priority only if policy uses it (BFS and Preemptive Priority)
-            if (pg->scheduler && pg->scheduler->policy != SCHED_POLICY_ROUND_ROBIN) {
-                printf("[Process Generator] Created process PID=%d TTL=%d Priority=%d (created_total=%d, in_system=%d/%d)\n", 
+            if (pg->scheduler && scheduler_policy_uses_priority(pg->scheduler->policy)) {
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Process Generator] Created process PID=%d TTL=%d Priority=%d (created_total=%d, in_system=%d/%d)\n", 
                        pending_pcb->pid, pending_pcb->ttl, pending_pcb->priority, pg->total_generated, 
                        total_processes + 1, pg->max_processes);
             } else {
-                printf("[Process Generator] Created process PID=%d TTL=%d (created_total=%d, in_system=%d/%d)\n", 
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Process Generator] Created process PID=%d TTL=%d (created_total=%d, in_system=%d/%d)\n", 
                        pending_pcb->pid, pending_pcb->ttl, pg->total_generated, 
                        total_processes + 1, pg->max_processes);
             }
-            fflush(stdout);
             
             // Clear pending PCB and calculate next generation time
             pending_pcb = NULL;
@@ -236,25 +269,29 @@ void* process_generator_function(void* arg) {
                 interval += rand() % (pg->max_interval - pg->min_interval + 1);
             }
             next_generation_tick = clk_counter + interval;
+            clock_schedule_event(next_generation_tick, EVENT_PROCESS_ARRIVAL, 0);
         } else {
             // Queue is full - print message only once
             if (!waiting_for_space) {
-                printf("[Process Generator] Ready queue full! Waiting for space...\n");
-                fflush(stdout);
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Process Generator] Ready queue full! Waiting for space...\n");
                 waiting_for_space = 1;
             }
             // Keep pending_pcb for next attempt, don't update next_generation_tick
         }
         
-        pthread_mutex_unlock(&clk_mutex);
+        clock_tick_arrive(pg->barrier_id, last_tick);
     }
     
+    // Señalizar antes de salir para no bloquear al reloj
+    clock_leave_tick_barrier(pg->barrier_id);
+    pthread_mutex_unlock(&clk_mutex);
+    
     // Cleanup pending PCB if any
     if (pending_pcb) {
         destroy_pcb(pending_pcb);
     }
     
-    printf("[Process Generator] Thread terminated\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Process Generator] Thread terminated\n");
     return NULL;
 }
 
@@ -284,6 +321,8 @@ ProcessGenerator* create_process_generator(int min_interval, int max_interval,
     pg->running = 0;
     pg->next_pid = start_pid;  // Start from provided PID
     pg->total_generated = 0;
+    pg->registered_tick = 0;
+    pg->barrier_id = -1;
     
     return pg;
 }
@@ -293,12 +332,21 @@ void start_process_generator(ProcessGenerator* pg) {
     if (!pg || pg->running) return;
     
     pg->running = 1;
+    
+    // Join the tick barrier before the thread exists so no tick goes by without it
+    pthread_mutex_lock(&clk_mutex);
+    pg->barrier_id = clock_join_tick_barrier("Process generator", &pg->registered_tick);
     int ret = pthread_create(&pg->thread, NULL, process_generator_function, pg);
+    if (ret != 0) {
+        clock_leave_tick_barrier(pg->barrier_id);
+    }
+    pthread_mutex_unlock(&clk_mutex);
+    
     if (ret != 0) {
         fprintf(stderr, "Error creating process generator thread: %s\n", strerror(ret));
         pg->running = 0;
     } else {
-        printf("[Process Generator] Started (interval: %d-%d ticks, TTL: %d-%d)\n",
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Process Generator] Started (interval: %d-%d ticks, TTL: %d-%d)\n",
                pg->min_interval, pg->max_interval, 
                pg->min_ttl, pg->max_ttl);
     }
@@ -310,7 +358,9 @@ void stop_process_generator(ProcessGenerator* pg) {
     
     pthread_mutex_lock(&clk_mutex);
     pg->running = 0;
+    clock_cancel_events(EVENT_PROCESS_ARRIVAL, 0);
     pthread_cond_broadcast(&clk_cond);  // Wake up the generator
+    pthread_cond_broadcast(&clk_idle_cond);
     pthread_mutex_unlock(&clk_mutex);
     
     pthread_join(pg->thread, NULL);
@@ -330,22 +380,281 @@ void destroy_process_generator(ProcessGenerator* pg) {
 // Scheduler with Quantum
 // ============================================================================
 
+int CFS_TARGET_LATENCY = 24;
+int MLFQ_BOOST_INTERVAL = 100;
+
+// CFS weight of each nice value (-20..19): one level less is ~10% more CPU time
+static const int cfs_nice_to_weight[NUM_PRIORITY_LEVELS] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15,
+};
+
 // Helper function: Check if there are processes ready to be scheduled
 static int has_ready_processes(Scheduler* sched) {
     if (sched->policy == SCHED_POLICY_PREEMPTIVE_PRIO) {
-        if (!sched->priority_queues) return 0;
-        for (int i = 0; i < NUM_PRIORITY_LEVELS; i++) {
-            if (sched->priority_queues[i] && sched->priority_queues[i]->current_size > 0) {
-                return 1;
-            }
-        }
-        return 0;
+        return sched->prio_bitmap != 0;
+    } else if (sched->policy == SCHED_POLICY_MLFQ) {
+        return sched->ready_queue->current_size > 0 || sched->prio_bitmap != 0;
+    } else if (sched->policy == SCHED_POLICY_BFS) {
+        return sched->ready_queue->current_size > 0 || sched->bfs_queue->size > 0;
+    } else if (sched->policy == SCHED_POLICY_RR_LOCAL || sched->policy == SCHED_POLICY_MUQSS) {
+        return sched->ready_queue->current_size > 0 || sched->local_count > 0;
+    } else if (sched->policy == SCHED_POLICY_CFS) {
+        return sched->ready_queue->current_size > 0 || sched->cfs_tree.size > 0;
+    } else if (sched->policy == SCHED_POLICY_SRPT) {
+        return sched->ready_queue->current_size > 0 || sched->srpt_queue->size > 0;
     } else {
         return sched->ready_queue && sched->ready_queue->current_size > 0;
     }
 }
 
+// Any process executing or waiting to be scheduled? (idle check of the clock)
+// Called with clk_mutex held.
+int scheduler_has_pending_work(Scheduler* sched) {
+    if (!sched) return 0;
+    if (sched->ready_queue && sched->ready_queue->current_size > 0) return 1;
+    if (sched->policy != SCHED_POLICY_ROUND_ROBIN && has_ready_processes(sched)) return 1;
+    return count_executing_processes(sched->machine) > 0;
+}
+
+// New processes were queued: wake the scheduler if it is in tickless idle.
+// Called with clk_mutex held.
+void scheduler_notify_work(Scheduler* sched) {
+    if (sched && sched->sync_mode == SCHED_SYNC_CLOCK) {
+        clock_wake_tick_participant(sched->barrier_id);
+    }
+}
+
+// Host time in nanoseconds, to measure how long picking a process takes
+static long long sched_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+// A process was taken from the run queues; the pick started at start_ns.
+// Atomic: with per-core queues the exec workers pick in parallel
+static void sched_account_pick(Scheduler* sched, long long start_ns) {
+    long long ns = sched_now_ns() - start_ns;
+    __sync_fetch_and_add(&sched->picks, 1);
+    __sync_fetch_and_add(&sched->pick_ns_total, ns);
+    long long max = sched->pick_ns_max;
+    while (ns > max && !__atomic_compare_exchange_n(&sched->pick_ns_max, &max, ns, 0,
+                                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Take the global lock, counting how often another thread (clock, loader,
+// timers) held it
+static void sched_lock_global(Scheduler* sched) {
+    if (pthread_mutex_trylock(&clk_mutex) != 0) {
+        sched->global_lock_contended++;
+        pthread_mutex_lock(&clk_mutex);
+    }
+    sched->global_lock_acquired++;
+}
+
+// Take the lock of a per-core queue, counting how often it was held
+static void sched_lock_queue(Scheduler* sched, pthread_mutex_t* lock) {
+    if (pthread_mutex_trylock(lock) != 0) {
+        __sync_fetch_and_add(&sched->queue_lock_contended, 1);
+        pthread_mutex_lock(lock);
+    }
+    __sync_fetch_and_add(&sched->queue_lock_acquired, 1);
+}
+
+// Try the lock of another core's queue: a thief never waits for it
+static int sched_trylock_queue(Scheduler* sched, pthread_mutex_t* lock) {
+    if (pthread_mutex_trylock(lock) != 0) {
+        __sync_fetch_and_add(&sched->queue_lock_contended, 1);
+        return 0;
+    }
+    __sync_fetch_and_add(&sched->queue_lock_acquired, 1);
+    return 1;
+}
+
+// BFS and MuQSS: virtual deadline = current tick + quantum * priority / 100
+// Called with clk_mutex held (MuQSS: maybe by an exec worker, the clock holds it).
+static void set_virtual_deadline(Scheduler* sched, PCB* pcb, int initial) {
+    int offset = (sched->quantum * pcb->priority) / 100;
+    int current_tick = clk_counter;  // Use clk_counter directly since we have mutex
+    pcb->virtual_deadline = current_tick + offset;
+    LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] %s: Process PID=%d %svirtual_deadline=%d (tick=%d, offset=%d, prio=%d)\n",
+           sched->policy == SCHED_POLICY_BFS ? "BFS" : "MuQSS", pcb->pid, initial ? "initial " : "",
+           pcb->virtual_deadline, current_tick, offset, pcb->priority);
+}
+
+// CFS weight of a process
+static int cfs_weight(PCB* pcb) {
+    int nice = pcb->priority;
+    if (nice < MIN_PRIORITY) nice = MIN_PRIORITY;
+    if (nice > MAX_PRIORITY) nice = MAX_PRIORITY;
+    return cfs_nice_to_weight[nice - MIN_PRIORITY];
+}
+
+// CFS tree order: lowest vruntime first, ties in arrival order
+static int cfs_before(const RBNode* a, const RBNode* b) {
+    return rb_entry(a, PCB, run_node)->vruntime < rb_entry(b, PCB, run_node)->vruntime;
+}
+
+// CFS: move the processes queued in ready_queue (loader, generator) to the tree.
+// They start at min_vruntime, so they neither wait behind nor starve the others
+static void cfs_collect_arrivals(Scheduler* sched) {
+    while (sched->ready_queue->current_size > 0) {
+        PCB* pcb = dequeue_process(sched->ready_queue);
+        pcb->vruntime = sched->min_vruntime;
+        sched->cfs_load += cfs_weight(pcb);
+        sched->cfs_running++;
+        rb_insert(&sched->cfs_tree, &pcb->run_node, cfs_before);
+    }
+}
+
+// CFS timeslice: the process's share (by weight) of the scheduling period.
+// The period is the target latency, stretched so that no slice is shorter
+// than the minimum granularity (the quantum)
+static int cfs_timeslice(Scheduler* sched, PCB* pcb) {
+    long min_granularity = sched->quantum;
+    long period = CFS_TARGET_LATENCY;
+    if (sched->cfs_running * min_granularity > period) {
+        period = sched->cfs_running * min_granularity;
+    }
+    long slice = period * cfs_weight(pcb) / (long)sched->cfs_load;
+    return slice < min_granularity ? (int)min_granularity : (int)slice;
+}
+
+// CFS: charge the ticks run since dispatch. vruntime counts in 1/1024 of a
+// tick of a nice 0 process, so lighter processes advance faster
+static void cfs_charge(PCB* pcb) {
+    unsigned long long ran = clk_counter - pcb->exec_start;
+    pcb->vruntime += ran * CFS_NICE_0_WEIGHT * CFS_NICE_0_WEIGHT / cfs_weight(pcb);
+}
+
+// Has the process used up its time on the hardware thread?
+static int quantum_expired(Scheduler* sched, PCB* pcb) {
+    // CFS: its own timeslice, in ticks since it was dispatched
+    if (sched->policy == SCHED_POLICY_CFS) {
+        return clk_counter - pcb->exec_start >= pcb->timeslice;
+    }
+    // MLFQ: level l gets l + 1 quanta
+    int quanta = (sched->policy == SCHED_POLICY_MLFQ) ? pcb->mlfq_level + 1 : 1;
+    // TIMER mode: quantum = timer interval, expires when timer fires (counter >= 1)
+    // CLOCK mode: quantum counted in ticks, expires after 'quantum' ticks
+    if (sched->sync_mode == SCHED_SYNC_TIMER) return pcb->quantum_counter >= quanta;
+    return pcb->quantum_counter >= sched->quantum * quanta;
+}
+
+// Append a process to priority queue idx. Returns 0 on success, -1 if full
+static int prio_queue_push(Scheduler* sched, int idx, PCB* pcb) {
+    if (enqueue_process(sched->priority_queues[idx], pcb) != 0) return -1;
+    sched->prio_bitmap |= 1ULL << idx;
+    sched->prio_count++;
+    return 0;
+}
+
+// Take the first process of the highest non-empty priority queue
+// The lowest set bit of the bitmap is the highest non-empty priority (-20 = bit 0)
+static PCB* prio_queue_pop(Scheduler* sched) {
+    if (!sched->priority_queues || sched->prio_bitmap == 0) return NULL;
+    
+    int queue_idx = __builtin_ctzll(sched->prio_bitmap);
+    ProcessQueue* pq = sched->priority_queues[queue_idx];
+    PCB* selected = dequeue_process(pq);
+    sched->prio_count--;
+    if (pq->current_size == 0) {
+        sched->prio_bitmap &= ~(1ULL << queue_idx);
+    }
+    return selected;
+}
+
+// MLFQ: new processes (loader, generator) enter at the top level
+static void mlfq_collect_arrivals(Scheduler* sched) {
+    while (sched->ready_queue->current_size > 0 &&
+           sched->priority_queues[0]->current_size < sched->priority_queues[0]->max_capacity) {
+        PCB* pcb = dequeue_process(sched->ready_queue);
+        pcb->mlfq_level = 0;
+        prio_queue_push(sched, 0, pcb);
+    }
+}
+
+// MLFQ: priority boost. Every process goes back to level 0, the waiting ones
+// in level order, so long jobs at the bottom can't starve. Called with clk_mutex held.
+static void mlfq_boost(Scheduler* sched) {
+    ProcessQueue* top = sched->priority_queues[0];
+    int moved = 0;
+    
+    uint64_t lower = sched->prio_bitmap & ~1ULL;
+    while (lower) {
+        int level = __builtin_ctzll(lower);
+        lower &= lower - 1;
+        ProcessQueue* pq = sched->priority_queues[level];
+        while (pq->current_size > 0 && top->current_size < top->max_capacity) {
+            PCB* pcb = dequeue_process(pq);
+            pcb->mlfq_level = 0;
+            enqueue_process(top, pcb);
+            moved++;
+        }
+        if (pq->current_size == 0) sched->prio_bitmap &= ~(1ULL << level);
+    }
+    if (top->current_size > 0) sched->prio_bitmap |= 1ULL;
+    
+    // The running ones too: their next quantum is a top-level one
+    Machine* machine = sched->machine;
+    for (int i = 0; i < machine->num_CPUs; i++) {
+        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
+            Core* core = &machine->cpus[i].cores[j];
+            for (int k = 0; k < core->num_kernel_threads; k++) {
+                PCB* pcb = core->hw_threads[k].pcb;
+                if (pcb && pcb->mlfq_level > 0) {
+                    pcb->mlfq_level = 0;
+                    moved++;
+                }
+            }
+        }
+    }
+    
+    sched->next_boost = clk_counter + MLFQ_BOOST_INTERVAL;
+    if (moved > 0) {
+        sched->boosts++;
+        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] MLFQ: priority boost at tick %d, %d process(es) back to level 0\n",
+               clk_counter, moved);
+    }
+}
+
 // Helper function: Select next process based on policy
+// BFS: move the processes queued in ready_queue (loader, generator) to the
+// deadline queue, in arrival order so ties keep FIFO order
+static void bfs_collect_arrivals(Scheduler* sched) {
+    while (sched->ready_queue->current_size > 0 &&
+           sched->bfs_queue->size < sched->bfs_queue->capacity) {
+        PCB* pcb = dequeue_process(sched->ready_queue);
+        run_queue_push(sched->bfs_queue, pcb, pcb->virtual_deadline);
+    }
+}
+
+// SRPT: instructions a process still has to execute. Without a count from the
+// loader (generated processes) its remaining TTL is the estimate
+static int srpt_remaining(PCB* pcb) {
+    if (pcb->total_instructions == 0) return pcb->ttl * INSTRUCTIONS_PER_TICK;
+    if (pcb->retired_instructions >= pcb->total_instructions) return 0;
+    unsigned long remaining = pcb->total_instructions - pcb->retired_instructions;
+    return remaining > INT_MAX ? INT_MAX : (int)remaining;
+}
+
+// SRPT: move the processes queued in ready_queue to the remaining work queue
+static void srpt_collect_arrivals(Scheduler* sched) {
+    while (sched->ready_queue->current_size > 0 &&
+           sched->srpt_queue->size < sched->srpt_queue->capacity) {
+        PCB* pcb = dequeue_process(sched->ready_queue);
+        run_queue_push(sched->srpt_queue, pcb, srpt_remaining(pcb));
+    }
+}
+
 static PCB* select_next_process(Scheduler* sched) {
     switch (sched->policy) {
         case SCHED_POLICY_ROUND_ROBIN:
@@ -353,68 +662,46 @@ static PCB* select_next_process(Scheduler* sched) {
             if (sched->ready_queue->current_size == 0) return NULL;
             return dequeue_process(sched->ready_queue);
             
-        case SCHED_POLICY_BFS: {
+        case SCHED_POLICY_BFS:
             // Brain Fuck Scheduler - select process with lowest virtual deadline
-            if (sched->ready_queue->current_size == 0) return NULL;
+            // (the earliest queued one on ties)
+            bfs_collect_arrivals(sched);
+            return (PCB*)run_queue_pop(sched->bfs_queue);
             
-            int min_deadline = -1;
-            int min_idx = -1;
-            int idx = sched->ready_queue->front;
-            
-            for (int i = 0; i < sched->ready_queue->current_size; i++) {
-                PCB* pcb = (PCB*)sched->ready_queue->queue[idx];
-                if (min_deadline == -1 || pcb->virtual_deadline < min_deadline) {
-                    min_deadline = pcb->virtual_deadline;
-                    min_idx = idx;
-                }
-                idx = (idx + 1) % sched->ready_queue->max_capacity;
-            }
-            
-            if (min_idx == -1) return NULL;
-            
-            // Remove selected process from queue
-            PCB* selected = (PCB*)sched->ready_queue->queue[min_idx];
+        case SCHED_POLICY_PREEMPTIVE_PRIO: {
+            // Preemptive with static priorities - use multiple priority queues
+            PCB* selected = prio_queue_pop(sched);
+            if (!selected) return NULL;
             
-            // Shift elements to fill the gap
-            int current_idx = min_idx;
-            for (int i = 0; i < sched->ready_queue->current_size - 1; i++) {
-                int next_idx = (current_idx + 1) % sched->ready_queue->max_capacity;
-                sched->ready_queue->queue[current_idx] = sched->ready_queue->queue[next_idx];
-                current_idx = next_idx;
+            ProcessQueue* pq = sched->priority_queues[selected->priority - MIN_PRIORITY];
+            if (pq->current_size > 0) {
+                LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] PRIORITY SELECTION: PID=%d (prio=%d) selected, %d more waiting at same priority\n",
+                       selected->pid, selected->priority, pq->current_size);
             }
-            
-            sched->ready_queue->current_size--;
-            sched->ready_queue->rear = (sched->ready_queue->rear - 1 + sched->ready_queue->max_capacity) 
-                                       % sched->ready_queue->max_capacity;
-            
             return selected;
         }
             
-        case SCHED_POLICY_PREEMPTIVE_PRIO: {
-            // Preemptive with static priorities - use multiple priority queues
-            // Search from highest priority (-20) to lowest (+19)
-            if (!sched->priority_queues) return NULL;
-            
-            for (int prio = MIN_PRIORITY; prio <= MAX_PRIORITY; prio++) {
-                int queue_idx = prio - MIN_PRIORITY;  // Convert priority to array index (0-39)
-                ProcessQueue* pq = sched->priority_queues[queue_idx];
-                
-                if (pq && pq->current_size > 0) {
-                    // Found a non-empty queue at this priority level
-                    PCB* selected = dequeue_process(pq);
-                    if (selected && pq->current_size > 0) {
-                        printf("[Scheduler] PRIORITY SELECTION: PID=%d (prio=%d) selected, %d more waiting at same priority\n",
-                               selected->pid, selected->priority, pq->current_size);
-                        fflush(stdout);
-                    }
-                    return selected;
-                }
-            }
+        case SCHED_POLICY_MLFQ:
+            // Multilevel feedback queue - first process of the highest non-empty level
+            mlfq_collect_arrivals(sched);
+            return prio_queue_pop(sched);
             
-            // No processes in any queue
-            return NULL;
+        case SCHED_POLICY_CFS: {
+            // Completely Fair Scheduler - the leftmost process has run the least
+            cfs_collect_arrivals(sched);
+            RBNode* first = sched->cfs_tree.leftmost;
+            if (!first) return NULL;
+            rb_erase(&sched->cfs_tree, first);
+            PCB* selected = rb_entry(first, PCB, run_node);
+            if (selected->vruntime > sched->min_vruntime) sched->min_vruntime = selected->vruntime;
+            return selected;
         }
             
+        case SCHED_POLICY_SRPT:
+            // Shortest remaining work - fewest instructions left to EXIT
+            srpt_collect_arrivals(sched);
+            return (PCB*)run_queue_pop(sched->srpt_queue);
+            
         default:
             if (sched->ready_queue && sched->ready_queue->current_size > 0) {
                 return dequeue_process(sched->ready_queue);
@@ -423,6 +710,85 @@ static PCB* select_next_process(Scheduler* sched) {
     }
 }
 
+// Local run queues (SCHED_POLICY_RR_LOCAL). Each queue has its own lock, so a
+// core only serializes with the cores that steal from it. The length is
+// published for the thieves, which choose a victim without locking.
+static int local_queue_push(Scheduler* sched, LocalRunQueue* lq, PCB* pcb) {
+    sched_lock_queue(sched, &lq->lock);
+    int ret = enqueue_process(lq->queue, pcb);
+    __atomic_store_n(&lq->length, lq->queue->current_size, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&lq->lock);
+    if (ret == 0) __sync_fetch_and_add(&sched->local_count, 1);
+    return ret;
+}
+
+// The owner core takes the oldest process
+static PCB* local_queue_pop(Scheduler* sched, LocalRunQueue* lq) {
+    sched_lock_queue(sched, &lq->lock);
+    PCB* pcb = dequeue_process(lq->queue);
+    __atomic_store_n(&lq->length, lq->queue->current_size, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&lq->lock);
+    if (pcb) __sync_fetch_and_sub(&sched->local_count, 1);
+    return pcb;
+}
+
+// A thief takes the newest process, skipping the queue if it is busy
+static PCB* local_queue_steal(Scheduler* sched, LocalRunQueue* lq) {
+    if (!sched_trylock_queue(sched, &lq->lock)) return NULL;
+    PCB* pcb = dequeue_process_tail(lq->queue);
+    if (pcb) lq->stolen++;
+    __atomic_store_n(&lq->length, lq->queue->current_size, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&lq->lock);
+    if (pcb) __sync_fetch_and_sub(&sched->local_count, 1);
+    return pcb;
+}
+
+// Publish the deadline of the first process, for the lockless peeks of the
+// other cores. Called with the queue lock held.
+static void muqss_publish_head(MuqssRunQueue* mq) {
+    SkipListNode* first = mq->list->head.next[0];
+    __atomic_store_n(&mq->head_deadline, first ? first->key : INT_MAX, __ATOMIC_RELEASE);
+}
+
+// MuQSS run queues (SCHED_POLICY_MUQSS): a skip list per core with its own lock
+static int muqss_queue_push(Scheduler* sched, MuqssRunQueue* mq, PCB* pcb) {
+    sched_lock_queue(sched, &mq->lock);
+    int ret = skip_list_insert(mq->list, pcb, pcb->virtual_deadline);
+    if (ret == 0) muqss_publish_head(mq);
+    pthread_mutex_unlock(&mq->lock);
+    if (ret == 0) __sync_fetch_and_add(&sched->local_count, 1);
+    return ret;
+}
+
+// Take the earliest deadline of a queue. A thief (steal=1) gives up if the
+// queue is locked; the owner waits for it
+static PCB* muqss_queue_pop(Scheduler* sched, MuqssRunQueue* mq, int steal) {
+    if (steal) {
+        if (!sched_trylock_queue(sched, &mq->lock)) return NULL;
+    } else {
+        sched_lock_queue(sched, &mq->lock);
+    }
+    PCB* pcb = (PCB*)skip_list_pop(mq->list);
+    if (pcb) {
+        muqss_publish_head(mq);
+        if (steal) mq->stolen++;
+    }
+    pthread_mutex_unlock(&mq->lock);
+    if (pcb) __sync_fetch_and_sub(&sched->local_count, 1);
+    return pcb;
+}
+
+// Core of the per-core queue a process goes to: the one it ran on, new
+// processes are spread round robin (RR_LOCAL and MUQSS)
+static int local_queue_core(Scheduler* sched, PCB* pcb) {
+    if (pcb->last_slot >= 0) {
+        return pcb->last_slot / sched->machine->threads_per_core;
+    }
+    int core_id = sched->next_local_queue;
+    sched->next_local_queue = (sched->next_local_queue + 1) % sched->num_local_queues;
+    return core_id;
+}
+
 // Helper function: Enqueue process to appropriate queue based on policy
 static int enqueue_to_scheduler(Scheduler* sched, PCB* pcb) {
     if (sched->policy == SCHED_POLICY_PREEMPTIVE_PRIO) {
@@ -435,55 +801,195 @@ static int enqueue_to_scheduler(Scheduler* sched, PCB* pcb) {
             return -1;
         }
         
-        int queue_idx = pcb->priority - MIN_PRIORITY;
-        return enqueue_process(sched->priority_queues[queue_idx], pcb);
+        return prio_queue_push(sched, pcb->priority - MIN_PRIORITY, pcb);
+    } else if (sched->policy == SCHED_POLICY_MLFQ) {
+        // Queue of its current level
+        return prio_queue_push(sched, pcb->mlfq_level, pcb);
+    } else if (sched->policy == SCHED_POLICY_BFS) {
+        // Deadline queue, behind the processes that arrived before
+        bfs_collect_arrivals(sched);
+        return run_queue_push(sched->bfs_queue, pcb, pcb->virtual_deadline);
+    } else if (sched->policy == SCHED_POLICY_RR_LOCAL) {
+        // Back to the core it ran on; new processes are spread round robin
+        return local_queue_push(sched, &sched->local_queues[local_queue_core(sched, pcb)], pcb);
+    } else if (sched->policy == SCHED_POLICY_MUQSS) {
+        // Same placement, ordered by virtual deadline inside the core's queue
+        return muqss_queue_push(sched, &sched->muqss_queues[local_queue_core(sched, pcb)], pcb);
+    } else if (sched->policy == SCHED_POLICY_CFS) {
+        // Back to the tree, behind the processes with the same vruntime
+        rb_insert(&sched->cfs_tree, &pcb->run_node, cfs_before);
+        return 0;
+    } else if (sched->policy == SCHED_POLICY_SRPT) {
+        // Keyed by the work left after the instructions it has retired
+        srpt_collect_arrivals(sched);
+        return run_queue_push(sched->srpt_queue, pcb, srpt_remaining(pcb));
     } else {
-        // Use single ready queue for RR and BFS
+        // Use single ready queue for RR
         return enqueue_process(sched->ready_queue, pcb);
     }
 }
 
-// Get the lowest priority process currently executing and its location
-// Returns the priority value, or MAX_PRIORITY+1 if no processes executing
-int get_lowest_priority_executing(Machine* machine, int* cpu_idx, int* core_idx, int* thread_idx) {
-    if (!machine) return MAX_PRIORITY + 1;
+// Count total processes in all priority queues (BFS: in the deadline queue,
+// SRPT: in the remaining work queue, RR_LOCAL and MUQSS: in the per-core queues)
+int count_processes_in_priority_queues(Scheduler* sched) {
+    if (sched && sched->bfs_queue) return sched->bfs_queue->size;
+    if (sched && sched->srpt_queue) return sched->srpt_queue->size;
+    if (sched && (sched->local_queues || sched->muqss_queues)) return sched->local_count;
+    if (sched && sched->policy == SCHED_POLICY_CFS) return sched->cfs_tree.size;
+    if (!sched || !sched->priority_queues) return 0;
+    return sched->prio_count;
+}
+
+// Run a process of a per-core queue on a free hardware thread of core_id
+static int start_local_process(Scheduler* sched, PCB* pcb, int core_id) {
+    pcb->state = RUNNING;
+    pcb->quantum_counter = 0;  // Reset quantum counter for new execution
+    if (sched->policy == SCHED_POLICY_MUQSS && pcb->virtual_deadline == 0) {
+        set_virtual_deadline(sched, pcb, 1);
+    }
+    if (!assign_process_to_core_id(sched->machine, pcb, core_id)) return 0;
+    
+    if (scheduler_policy_uses_priority(sched->policy)) {
+        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Process PID=%d assigned to execution (TTL=%d, Priority=%d)\n",
+               pcb->pid, pcb->ttl, pcb->priority);
+    } else {
+        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Process PID=%d assigned to execution (TTL=%d)\n",
+               pcb->pid, pcb->ttl);
+    }
+    return 1;
+}
+
+// New processes (loader, generator) arrive through ready_queue: move them to
+// the per-core queues
+static void collect_local_arrivals(Scheduler* sched) {
+    while (sched->ready_queue->current_size > 0) {
+        PCB* pcb = dequeue_process(sched->ready_queue);
+        if (enqueue_to_scheduler(sched, pcb) != 0) {
+            // Local queue full, leave it in the inbox
+            enqueue_process(sched->ready_queue, pcb);
+            break;
+        }
+    }
+}
+
+// Processes queued on core v beyond what its free hardware threads will take
+// (read without locks: only a hint for choosing a victim)
+static int local_queue_surplus(Scheduler* sched, int v) {
+    Core* core = get_machine_core(sched->machine, v);
+    uint64_t free_mask = __atomic_load_n(&core->free_mask, __ATOMIC_RELAXED);
+    return __atomic_load_n(&sched->local_queues[v].length, __ATOMIC_RELAXED) - __builtin_popcountll(free_mask);
+}
+
+// SCHED_POLICY_RR_LOCAL: core c fills its free hardware threads from the head of
+// its own queue, then steals from the tail of the queue with the largest surplus.
+static void dispatch_local_core(Scheduler* sched, int c) {
+    Machine* machine = sched->machine;
+    Core* core = get_machine_core(machine, c);
     
-    int lowest_priority = MAX_PRIORITY + 1;
-    *cpu_idx = -1;
-    *core_idx = -1;
-    *thread_idx = -1;
+    while (core->free_mask && sched->local_count > 0) {
+        long long pick_start = sched_now_ns();
+        PCB* pcb = local_queue_pop(sched, &sched->local_queues[c]);
+        if (!pcb) break;
+        sched_account_pick(sched, pick_start);
+        start_local_process(sched, pcb, c);
+    }
     
-    for (int i = 0; i < machine->num_CPUs; i++) {
-        for (int j = 0; j < machine->cpus[i].num_cores; j++) {
-            Core* core = &machine->cpus[i].cores[j];
-            for (int k = 0; k < core->current_pcb_count; k++) {
-                PCB* pcb = &core->pcbs[k];
-                // Lower priority value = higher importance
-                // We want highest priority number (lowest importance)
-                if (pcb->priority > lowest_priority || lowest_priority == MAX_PRIORITY + 1) {
-                    lowest_priority = pcb->priority;
-                    *cpu_idx = i;
-                    *core_idx = j;
-                    *thread_idx = k;
-                }
+    // Work stealing: idle threads take work the busy cores can't run now
+    while (core->free_mask && sched->local_count > 0) {
+        long long pick_start = sched_now_ns();
+        int victim = -1;
+        int best = 0;
+        for (int v = 0; v < sched->num_local_queues; v++) {
+            int surplus = v == c ? 0 : local_queue_surplus(sched, v);
+            if (surplus > best) {
+                victim = v;
+                best = surplus;
             }
         }
+        if (victim < 0) break;
+        
+        PCB* pcb = local_queue_steal(sched, &sched->local_queues[victim]);
+        if (!pcb) break;  // Victim busy: try again next activation
+        
+        sched_account_pick(sched, pick_start);
+        __sync_fetch_and_add(&sched->steals, 1);
+        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CPU%d-Core%d stole PID=%d from CPU%d-Core%d\n",
+               c / machine->cores_per_cpu, c % machine->cores_per_cpu, pcb->pid,
+               victim / machine->cores_per_cpu, victim % machine->cores_per_cpu);
+        start_local_process(sched, pcb, c);
     }
+}
+
+// MuQSS pick for core c: peek without locking at the first deadline of every
+// queue and take the earliest one. Another core's queue is only used if its
+// deadline is strictly earlier and its lock is free; otherwise the core takes
+// its own first process
+static PCB* muqss_pick(Scheduler* sched, int c, int* from) {
+    int best = c;
+    int best_deadline = __atomic_load_n(&sched->muqss_queues[c].head_deadline, __ATOMIC_ACQUIRE);
+    for (int v = 0; v < sched->num_local_queues; v++) {
+        int deadline = __atomic_load_n(&sched->muqss_queues[v].head_deadline, __ATOMIC_ACQUIRE);
+        if (deadline < best_deadline) {
+            best = v;
+            best_deadline = deadline;
+        }
+    }
+    if (best_deadline == INT_MAX) return NULL;
     
-    return lowest_priority;
+    if (best != c) {
+        PCB* pcb = muqss_queue_pop(sched, &sched->muqss_queues[best], 1);
+        if (pcb) {
+            *from = best;
+            return pcb;
+        }
+    }
+    *from = c;
+    return muqss_queue_pop(sched, &sched->muqss_queues[c], 0);
 }
 
-// Count total processes in all priority queues
-int count_processes_in_priority_queues(Scheduler* sched) {
-    if (!sched || !sched->priority_queues) return 0;
+// SCHED_POLICY_MUQSS: core c fills its free hardware threads with the earliest
+// virtual deadline it can see.
+static void dispatch_muqss_core(Scheduler* sched, int c) {
+    Machine* machine = sched->machine;
+    Core* core = get_machine_core(machine, c);
     
-    int total = 0;
-    for (int i = 0; i < NUM_PRIORITY_LEVELS; i++) {
-        if (sched->priority_queues[i]) {
-            total += sched->priority_queues[i]->current_size;
+    while (core->free_mask && sched->local_count > 0) {
+        long long pick_start = sched_now_ns();
+        int from;
+        PCB* pcb = muqss_pick(sched, c, &from);
+        if (!pcb) break;
+        sched_account_pick(sched, pick_start);
+        
+        if (from != c) {
+            __sync_fetch_and_add(&sched->steals, 1);
+            LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CPU%d-Core%d stole PID=%d (deadline=%d) from CPU%d-Core%d\n",
+                   c / machine->cores_per_cpu, c % machine->cores_per_cpu, pcb->pid,
+                   pcb->virtual_deadline, from / machine->cores_per_cpu, from % machine->cores_per_cpu);
         }
+        start_local_process(sched, pcb, c);
+    }
+}
+
+// Per-core queues (RR_LOCAL and MUQSS): the scheduler thread only queues the
+// processes; every core takes its own ones in the next tick. Returns 1 if the
+// cores must pick in this tick, and clears the request. Called by the clock
+// with clk_mutex held.
+int scheduler_take_dispatch(Scheduler* sched) {
+    if (!sched || !sched->dispatch_pending) return 0;
+    sched->dispatch_pending = 0;
+    return 1;
+}
+
+// Fill the free hardware threads of core c (cpu * cores_per_cpu + core) from the
+// per-core queues. Called in the tick phase of the core, before it executes: by
+// its exec worker under -par 1, so the cores pick in parallel and only meet at
+// the queue locks (the scheduler thread waits at the tick barrier meanwhile).
+void scheduler_dispatch_core(Scheduler* sched, int c) {
+    if (sched->policy == SCHED_POLICY_RR_LOCAL) {
+        dispatch_local_core(sched, c);
+    } else if (sched->policy == SCHED_POLICY_MUQSS) {
+        dispatch_muqss_core(sched, c);
     }
-    return total;
 }
 
 // Preempt processes of lower priority if a higher priority process arrives
@@ -498,33 +1004,25 @@ void preempt_lower_priority_processes(Scheduler* sched, PCB* new_pcb) {
     
     // If new process has higher priority (lower number), preempt the lowest priority one
     if (lowest_prio != MAX_PRIORITY + 1 && new_pcb->priority < lowest_prio) {
-        Core* core = &sched->machine->cpus[cpu_idx].cores[core_idx];
-        PCB* preempted_pcb = &core->pcbs[thread_idx];
+        HardwareThread* hw_thread = &sched->machine->cpus[cpu_idx].cores[core_idx].hw_threads[thread_idx];
+        PCB* preempted_pcb = hw_thread->pcb;
         
-        printf("[Scheduler] PREEMPTION: Process PID=%d (prio=%d) preempting PID=%d (prio=%d) on CPU%d-Core%d-Thread%d\n",
+        // No room to requeue it: keep it running
+        ProcessQueue* pq = sched->priority_queues[preempted_pcb->priority - MIN_PRIORITY];
+        if (pq->current_size >= pq->max_capacity) return;
+        
+        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] PREEMPTION: Process PID=%d (prio=%d) preempting PID=%d (prio=%d) on CPU%d-Core%d-Thread%d\n",
                new_pcb->pid, new_pcb->priority, preempted_pcb->pid, preempted_pcb->priority, 
                cpu_idx, core_idx, thread_idx);
-        fflush(stdout);
-        
-        // Save the preempted process state
-        PCB* saved_pcb = create_pcb(preempted_pcb->pid);
-        if (saved_pcb) {
-            saved_pcb->state = WAITING;
-            saved_pcb->priority = preempted_pcb->priority;
-            saved_pcb->ttl = preempted_pcb->ttl;
-            saved_pcb->initial_ttl = preempted_pcb->initial_ttl;
-            saved_pcb->quantum_counter = 0;  // Reset quantum when preempted
-            saved_pcb->virtual_deadline = preempted_pcb->virtual_deadline;
-            
-            // Return to appropriate priority queue
-            enqueue_to_scheduler(sched, saved_pcb);
-        }
         
-        // Remove preempted process from core
-        for (int l = thread_idx; l < core->current_pcb_count - 1; l++) {
-            core->pcbs[l] = core->pcbs[l + 1];
-        }
-        core->current_pcb_count--;
+        // Save the preempted process state in its own PCB (keeps its memory management state)
+        save_hw_thread_context(hw_thread, preempted_pcb);
+        preempted_pcb->state = WAITING;
+        preempted_pcb->quantum_counter = 0;  // Reset quantum when preempted
+        
+        // Remove preempted process from core and return it to its priority queue
+        release_hw_thread(sched->machine, cpu_idx, core_idx, thread_idx);
+        enqueue_to_scheduler(sched, preempted_pcb);
     }
 }
 
@@ -533,24 +1031,27 @@ void preempt_lower_priority_processes(Scheduler* sched, PCB* new_pcb) {
 // or by clock ticks (for SCHED_SYNC_CLOCK). The clock itself decrements TTL.
 void* scheduler_function(void* arg) {
     Scheduler* sched = (Scheduler*)arg;
-    int last_tick = 0;
+    int last_tick = sched->registered_tick;  // CLOCK mode: joined the tick barrier in start_scheduler
+    unsigned long activation = 0;  // TIMER mode: activation being handled
     
     while (sched->running && running) {
         if (sched->sync_mode == SCHED_SYNC_TIMER) {
             // Wait for scheduler activation signal from timer
             pthread_mutex_lock(&sched->sched_mutex);
-            pthread_cond_wait(&sched->sched_cond, &sched->sched_mutex);
+            while (sched->running && running && sched->activations_done == sched->activations) {
+                pthread_cond_wait(&sched->sched_cond, &sched->sched_mutex);
+            }
+            activation = sched->activations;
             pthread_mutex_unlock(&sched->sched_mutex);
             
             if (!sched->running || !running) {
                 break;
             }
             
-            printf("[Scheduler] Activated by Timer at tick %d\n", get_current_tick());
-            fflush(stdout);
+            LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Activated by Timer at tick %d\n", get_current_tick());
         } else {
             // SCHED_SYNC_CLOCK: Wait for clock ticks
-            pthread_mutex_lock(&clk_mutex);
+            sched_lock_global(sched);
             
             // Wait for next clock tick
             while (sched->running && running && clk_counter == last_tick) {
@@ -570,7 +1071,7 @@ void* scheduler_function(void* arg) {
         // NOTE: TTL decrement is done by the clock, not here!
         // For TIMER mode, we need to lock. For CLOCK mode, we already have the lock
         if (sched->sync_mode == SCHED_SYNC_TIMER) {
-            pthread_mutex_lock(&clk_mutex);
+            sched_lock_global(sched);
         }
         
         // Process all currently executing processes in all cores
@@ -579,8 +1080,8 @@ void* scheduler_function(void* arg) {
                 for (int j = 0; j < sched->machine->cpus[i].num_cores && running; j++) {
                     Core* core = &sched->machine->cpus[i].cores[j];
                     
-                    // Process each hardware thread in this core (iterate backwards to safely remove)
-                    for (int k = core->current_pcb_count - 1; k >= 0 && running; k--) {
+                    // Process each hardware thread in this core (slots are stable, idle ones are skipped)
+                    for (int k = core->num_kernel_threads - 1; k >= 0 && running; k--) {
                         HardwareThread* hw_thread = &core->hw_threads[k];
                         PCB* pcb = hw_thread->pcb;
                         
@@ -594,23 +1095,23 @@ void* scheduler_function(void* arg) {
                         
                         if (sched->sync_mode == SCHED_SYNC_TIMER) {
                             // In TIMER mode: timer fires periodically, quantum = timer interval
-                            printf("[Scheduler] CPU%d-Core%d-Thread%d: Process PID=%d (TTL=%d, quantum expired)\n", 
+                            LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CPU%d-Core%d-Thread%d: Process PID=%d (TTL=%d, quantum expired)\n", 
                                    i, j, k, pcb->pid, pcb->ttl);
                         } else {
                             // In CLOCK mode: activated every tick, show quantum progress
-                            printf("[Scheduler] CPU%d-Core%d-Thread%d: Process PID=%d (TTL=%d, quantum=%d/%d)\n", 
-                                   i, j, k, pcb->pid, pcb->ttl, pcb->quantum_counter, sched->quantum);
+                            LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CPU%d-Core%d-Thread%d: Process PID=%d (TTL=%d, quantum=%d/%d)\n", 
+                                   i, j, k, pcb->pid, pcb->ttl, pcb->quantum_counter,
+                                   sched->policy == SCHED_POLICY_CFS ? pcb->timeslice : sched->quantum);
                         }
-                        fflush(stdout);
                         
                         // Check if process terminated (by EXIT instruction or TTL reached 0)
                         if (pcb->state == TERMINATED || pcb->ttl <= 0) {
                             // Process completed
                             const char* reason = (pcb->state == TERMINATED) ? "EXIT" : "TTL=0";
-                            printf("[Scheduler] Process PID=%d COMPLETED (%s) - removing from CPU%d-Core%d-Thread%d\n", 
-                                   pcb->pid, reason, i, j, k);
-                            fflush(stdout);
+                            LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Scheduler] Process PID=%d COMPLETED (%s, %lu instructions) - removing from CPU%d-Core%d-Thread%d\n", 
+                                   pcb->pid, reason, pcb->retired_instructions, i, j, k);
                             __sync_fetch_and_add(&sched->total_completed, 1);
+                            sched->turnaround_total += clk_counter - pcb->arrival_tick;
                             
                             // Free the PCB and its resources (page table, etc.)
                             if (pcb->mm.pgb) {
@@ -619,60 +1120,56 @@ void* scheduler_function(void* arg) {
                                 pcb->mm.pgb = NULL;
                             }
                             
-                            // Destroy the PCB
-                            destroy_pcb(pcb);
+                            // Its translations can't be used again: drop them from every TLB
+                            invalidate_tlb_asid(sched->machine, (uint32_t)pcb->pid);
                             
-                            // Clear hardware thread
-                            hw_thread->pcb = NULL;
-                            hw_thread->PTBR = NULL;
-                            hw_thread->PC = 0;
-                            hw_thread->IR = 0;
-                            hw_thread->mmu.page_table_base = NULL;
-                            hw_thread->mmu.enabled = 0;
-                            
-                            // Shift remaining hardware threads and PCBs
-                            for (int l = k; l < core->current_pcb_count - 1; l++) {
-                                core->hw_threads[l] = core->hw_threads[l + 1];
-                                core->pcbs[l] = core->pcbs[l + 1];
+                            // It no longer competes for the CPU
+                            if (sched->policy == SCHED_POLICY_CFS) {
+                                sched->cfs_load -= cfs_weight(pcb);
+                                sched->cfs_running--;
                             }
                             
-                            // Clear the last one
-                            core->hw_threads[core->current_pcb_count - 1].pcb = NULL;
-                            core->hw_threads[core->current_pcb_count - 1].PTBR = NULL;
-                            
-                            core->current_pcb_count--;
+                            // Free the hardware thread and destroy the PCB
+                            release_hw_thread(sched->machine, i, j, k);
+                            destroy_pcb(pcb);
                             
-                        } else if ((sched->sync_mode == SCHED_SYNC_TIMER && pcb->quantum_counter >= 1) ||
-                                   (sched->sync_mode == SCHED_SYNC_CLOCK && pcb->quantum_counter >= sched->quantum)) {
-                            // TIMER mode: quantum = timer interval, expires when timer fires (counter >= 1)
-                            // CLOCK mode: quantum counted in ticks, expires after 'quantum' ticks
-                            printf("[Scheduler] Process PID=%d quantum expired - moving from CPU%d-Core%d-Thread%d to READY\n", 
+                        } else if (quantum_expired(sched, pcb)) {
+                            LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Process PID=%d quantum expired - moving from CPU%d-Core%d-Thread%d to READY\n", 
                                    pcb->pid, i, j, k);
-                            fflush(stdout);
                             
                             // Save hardware thread context to PCB BEFORE clearing
-                            HardwareThread* hw_thread = &core->hw_threads[k];
-                            pcb->context.pc = hw_thread->PC;
-                            pcb->context.instruction = hw_thread->IR;
-                            for (int r = 0; r < 16; r++) {
-                                pcb->context.registers[r] = hw_thread->registers[r];
-                            }
+                            save_hw_thread_context(hw_thread, pcb);
                             
                             // Move the ORIGINAL PCB back to ready queue (don't create a copy)
                             // This preserves all memory management state
                             pcb->state = WAITING;
                             pcb->quantum_counter = 0;  // Reset quantum counter
                             
-                            // Calculate virtual deadline for BFS
-                            if (sched->policy == SCHED_POLICY_BFS) {
-                                // deadline = T_actual + offset
-                                // offset = rodaja_de_tiempo * prioridad / 100
-                                int offset = (sched->quantum * pcb->priority) / 100;
-                                int current_tick = clk_counter;  // Use clk_counter directly since we have mutex
-                                pcb->virtual_deadline = current_tick + offset;
-                                printf("[Scheduler] BFS: Process PID=%d virtual_deadline=%d (tick=%d, offset=%d, prio=%d)\n",
-                                       pcb->pid, pcb->virtual_deadline, current_tick, offset, pcb->priority);
-                                fflush(stdout);
+                            // Calculate virtual deadline for BFS and MuQSS
+                            // deadline = T_actual + offset
+                            // offset = rodaja_de_tiempo * prioridad / 100
+                            if (sched->policy == SCHED_POLICY_BFS || sched->policy == SCHED_POLICY_MUQSS) {
+                                set_virtual_deadline(sched, pcb, 0);
+                            }
+                            
+                            // MLFQ: it used its whole quantum, one level down
+                            if (sched->policy == SCHED_POLICY_MLFQ && pcb->mlfq_level < NUM_PRIORITY_LEVELS - 1) {
+                                pcb->mlfq_level++;
+                                LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] MLFQ: Process PID=%d used its full quantum, demoted to level %d\n",
+                                       pcb->pid, pcb->mlfq_level);
+                            }
+                            
+                            // CFS: charge the ticks it ran, weighted by its nice value
+                            if (sched->policy == SCHED_POLICY_CFS) {
+                                cfs_charge(pcb);
+                                LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CFS: Process PID=%d vruntime=%llu (ran %d ticks, nice=%d)\n",
+                                       pcb->pid, pcb->vruntime, clk_counter - pcb->exec_start, pcb->priority);
+                            }
+                            
+                            // SRPT: back in order of the work it has left
+                            if (sched->policy == SCHED_POLICY_SRPT) {
+                                LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] SRPT: Process PID=%d has %d instructions left (%lu retired)\n",
+                                       pcb->pid, srpt_remaining(pcb), pcb->retired_instructions);
                             }
                             
                             enqueue_to_scheduler(sched, pcb);
@@ -685,24 +1182,7 @@ void* scheduler_function(void* arg) {
                             }
                             
                             // Remove from core by clearing the hardware thread
-                            hw_thread->pcb = NULL;
-                            hw_thread->PTBR = NULL;
-                            hw_thread->PC = 0;
-                            hw_thread->IR = 0;
-                            hw_thread->mmu.page_table_base = NULL;
-                            hw_thread->mmu.enabled = 0;
-                            
-                            // Shift remaining hardware threads
-                            for (int l = k; l < core->current_pcb_count - 1; l++) {
-                                core->hw_threads[l] = core->hw_threads[l + 1];
-                                core->pcbs[l] = core->pcbs[l + 1];
-                            }
-                            
-                            // Clear the last one
-                            core->hw_threads[core->current_pcb_count - 1].pcb = NULL;
-                            core->hw_threads[core->current_pcb_count - 1].PTBR = NULL;
-                            
-                            core->current_pcb_count--;
+                            release_hw_thread(sched->machine, i, j, k);
                         }
                     }
                 }
@@ -735,32 +1215,49 @@ void* scheduler_function(void* arg) {
             }
         }
         
-        while (running && has_ready_processes(sched) && can_cpu_execute_process(sched->machine)) {
+        // MLFQ: periodic priority boost
+        if (sched->policy == SCHED_POLICY_MLFQ && MLFQ_BOOST_INTERVAL > 0 && clk_counter >= sched->next_boost) {
+            mlfq_boost(sched);
+        }
+        
+        // Per-core queues: the cores pick from them at the start of the next tick
+        if (sched->num_local_queues > 0 && running) {
+            collect_local_arrivals(sched);
+            sched->dispatch_pending = sched->local_count > 0;
+        }
+        
+        while (running && sched->num_local_queues == 0 &&
+               has_ready_processes(sched) && can_cpu_execute_process(sched->machine)) {
+            long long pick_start = sched_now_ns();
             PCB* pcb = select_next_process(sched);
             if (pcb) {
+                sched_account_pick(sched, pick_start);
+
                 pcb->state = RUNNING;
                 pcb->quantum_counter = 0;  // Reset quantum counter for new execution
                 
                 // Calculate virtual deadline for BFS when assigning for first time
                 if (sched->policy == SCHED_POLICY_BFS && pcb->virtual_deadline == 0) {
-                    int offset = (sched->quantum * pcb->priority) / 100;
-                    int current_tick = clk_counter;  // Use clk_counter directly since we have mutex
-                    pcb->virtual_deadline = current_tick + offset;
-                    printf("[Scheduler] BFS: Process PID=%d initial virtual_deadline=%d (tick=%d, offset=%d, prio=%d)\n",
-                           pcb->pid, pcb->virtual_deadline, current_tick, offset, pcb->priority);
-                    fflush(stdout);
+                    set_virtual_deadline(sched, pcb, 1);
+                }
+                
+                // CFS: slice of the period for this run
+                if (sched->policy == SCHED_POLICY_CFS) {
+                    pcb->timeslice = cfs_timeslice(sched, pcb);
+                    pcb->exec_start = clk_counter;
+                    LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] CFS: Process PID=%d vruntime=%llu slice=%d ticks (weight=%d, load=%lu)\n",
+                           pcb->pid, pcb->vruntime, pcb->timeslice, cfs_weight(pcb), sched->cfs_load);
                 }
                 
                 if (assign_process_to_core(sched->machine, pcb)) {
                     // Print priority only if policy uses it (BFS and Preemptive Priority)
-                    if (sched->policy != SCHED_POLICY_ROUND_ROBIN) {
-                        printf("[Scheduler] Process PID=%d assigned to execution (TTL=%d, Priority=%d)\n", 
+                    if (scheduler_policy_uses_priority(sched->policy)) {
+                        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Process PID=%d assigned to execution (TTL=%d, Priority=%d)\n", 
                                pcb->pid, pcb->ttl, pcb->priority);
                     } else {
-                        printf("[Scheduler] Process PID=%d assigned to execution (TTL=%d)\n", 
+                        LOG_PRINTF(LOG_LEVEL_TICK, "[Scheduler] Process PID=%d assigned to execution (TTL=%d)\n", 
                                pcb->pid, pcb->ttl);
                     }
-                    fflush(stdout);
                     
                     // DO NOT free the PCB - it's still being used by the hardware thread
                     // The PCB will be freed when the process completes or is removed
@@ -774,13 +1271,49 @@ void* scheduler_function(void* arg) {
             }
         }
         
+        if (sched->sync_mode == SCHED_SYNC_CLOCK) {
+            clock_tick_arrive(sched->barrier_id, last_tick);
+            
+            // Tickless idle: nothing running or waiting, sleep until work is enqueued
+            if (TICKLESS_ENABLED && running && !scheduler_has_pending_work(sched)) {
+                last_tick = clock_tick_idle(sched->barrier_id, -1, &sched->running) - 1;
+            }
+        }
+        pthread_mutex_unlock(&clk_mutex);
+        
+        if (sched->sync_mode == SCHED_SYNC_TIMER) {
+            // Let the timer that activated us ack its tick
+            pthread_mutex_lock(&sched->sched_mutex);
+            sched->activations_done = activation;
+            pthread_cond_broadcast(&sched->sched_cond);
+            pthread_mutex_unlock(&sched->sched_mutex);
+        }
+    }
+    
+    if (sched->sync_mode == SCHED_SYNC_CLOCK) {
+        pthread_mutex_lock(&clk_mutex);
+        clock_leave_tick_barrier(sched->barrier_id);
         pthread_mutex_unlock(&clk_mutex);
     }
     
-    printf("[Scheduler] Thread terminated\n");
+    LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Scheduler] Thread terminated\n");
     return NULL;
 }
 
+// Name of a scheduling policy
+const char* scheduler_policy_name(int policy) {
+    static const char* policy_names[] = {"Round Robin", "BFS", "Preemptive Priority",
+                                         "Round Robin (per-core queues)", "MuQSS", "CFS", "MLFQ", "SRPT"};
+    if (policy < 0 || policy >= SCHED_NUM_POLICIES) return "unknown";
+    return policy_names[policy];
+}
+
+// Does the policy look at the priority of the processes?
+int scheduler_policy_uses_priority(int policy) {
+    return policy == SCHED_POLICY_BFS || policy == SCHED_POLICY_PREEMPTIVE_PRIO ||
+           policy == SCHED_POLICY_MUQSS || policy == SCHED_POLICY_CFS;
+}
+
 // Create a new scheduler with default policy (Round Robin, clock sync)
 Scheduler* create_scheduler(int quantum, ProcessQueue* ready_queue, Machine* machine) {
     return create_scheduler_with_policy(quantum, SCHED_POLICY_ROUND_ROBIN, 
@@ -797,7 +1330,7 @@ Scheduler* create_scheduler_with_policy(int quantum, int policy, int sync_mode,
     }
     
     // Validate policy
-    if (policy < SCHED_POLICY_ROUND_ROBIN || policy > SCHED_POLICY_PREEMPTIVE_PRIO) {
+    if (policy < SCHED_POLICY_ROUND_ROBIN || policy >= SCHED_NUM_POLICIES) {
         fprintf(stderr, "Invalid scheduler policy: %d\n", policy);
         return NULL;
     }
@@ -823,13 +1356,119 @@ Scheduler* create_scheduler_with_policy(int quantum, int policy, int sync_mode,
     sched->running = 0;
     sched->total_completed = 0;
     sched->priority_queues = NULL;
+    sched->prio_bitmap = 0;
+    sched->prio_count = 0;
+    sched->bfs_queue = NULL;
+    sched->srpt_queue = NULL;
+    sched->local_queues = NULL;
+    sched->muqss_queues = NULL;
+    sched->num_local_queues = 0;
+    sched->next_local_queue = 0;
+    sched->local_count = 0;
+    sched->dispatch_pending = 0;
+    sched->steals = 0;
+    sched->picks = 0;
+    sched->pick_ns_total = 0;
+    sched->pick_ns_max = 0;
+    sched->global_lock_acquired = 0;
+    sched->global_lock_contended = 0;
+    sched->queue_lock_acquired = 0;
+    sched->queue_lock_contended = 0;
+    rb_tree_init(&sched->cfs_tree);
+    sched->min_vruntime = 0;
+    sched->cfs_load = 0;
+    sched->cfs_running = 0;
+    sched->next_boost = MLFQ_BOOST_INTERVAL;
+    sched->boosts = 0;
+    sched->turnaround_total = 0;
     
     // Initialize scheduler mutex and condition variable
     pthread_mutex_init(&sched->sched_mutex, NULL);
     pthread_cond_init(&sched->sched_cond, NULL);
+    sched->activations = 0;
+    sched->activations_done = 0;
+    sched->registered_tick = 0;
+    sched->barrier_id = -1;
+    
+    // Create the deadline queue if using BFS policy (same capacity as the ready queue)
+    if (policy == SCHED_POLICY_BFS) {
+        sched->bfs_queue = create_run_queue(ready_queue->max_capacity);
+        if (!sched->bfs_queue) {
+            fprintf(stderr, "Failed to create BFS run queue\n");
+            free(sched);
+            return NULL;
+        }
+    }
+    
+    // Create the remaining work queue if using SRPT policy (same capacity as the ready queue)
+    if (policy == SCHED_POLICY_SRPT) {
+        sched->srpt_queue = create_run_queue(ready_queue->max_capacity);
+        if (!sched->srpt_queue) {
+            fprintf(stderr, "Failed to create SRPT run queue\n");
+            free(sched);
+            return NULL;
+        }
+    }
+    
+    // Create one local run queue per core if using RR_LOCAL policy
+    // (each one can hold the whole ready queue: stealing never has to give up)
+    if (policy == SCHED_POLICY_RR_LOCAL) {
+        int num_cores = machine->num_CPUs * machine->cores_per_cpu;
+        sched->local_queues = malloc(sizeof(LocalRunQueue) * num_cores);
+        if (!sched->local_queues) {
+            fprintf(stderr, "Failed to allocate local run queues\n");
+            free(sched);
+            return NULL;
+        }
+        for (int c = 0; c < num_cores; c++) {
+            sched->local_queues[c].queue = create_process_queue(ready_queue->max_capacity);
+            if (!sched->local_queues[c].queue) {
+                fprintf(stderr, "Failed to create local run queue %d\n", c);
+                for (int d = 0; d < c; d++) {
+                    destroy_process_queue(sched->local_queues[d].queue);
+                    pthread_mutex_destroy(&sched->local_queues[d].lock);
+                }
+                free(sched->local_queues);
+                free(sched);
+                return NULL;
+            }
+            pthread_mutex_init(&sched->local_queues[c].lock, NULL);
+            sched->local_queues[c].length = 0;
+            sched->local_queues[c].stolen = 0;
+        }
+        sched->num_local_queues = num_cores;
+    }
     
-    // Create priority queues if using PREEMPTIVE_PRIO policy
-    if (policy == SCHED_POLICY_PREEMPTIVE_PRIO) {
+    // Create one deadline queue per core if using MUQSS policy
+    if (policy == SCHED_POLICY_MUQSS) {
+        int num_cores = machine->num_CPUs * machine->cores_per_cpu;
+        sched->muqss_queues = malloc(sizeof(MuqssRunQueue) * num_cores);
+        if (!sched->muqss_queues) {
+            fprintf(stderr, "Failed to allocate MuQSS run queues\n");
+            free(sched);
+            return NULL;
+        }
+        for (int c = 0; c < num_cores; c++) {
+            sched->muqss_queues[c].list = create_skip_list(ready_queue->max_capacity);
+            if (!sched->muqss_queues[c].list) {
+                fprintf(stderr, "Failed to create MuQSS run queue %d\n", c);
+                for (int d = 0; d < c; d++) {
+                    destroy_skip_list(sched->muqss_queues[d].list);
+                    pthread_mutex_destroy(&sched->muqss_queues[d].lock);
+                }
+                free(sched->muqss_queues);
+                free(sched);
+                return NULL;
+            }
+            pthread_mutex_init(&sched->muqss_queues[c].lock, NULL);
+            sched->muqss_queues[c].head_deadline = INT_MAX;
+            sched->muqss_queues[c].stolen = 0;
+        }
+        sched->num_local_queues = num_cores;
+    }
+    
+    // Create priority queues if using PREEMPTIVE_PRIO or MLFQ policy
+    if (policy == SCHED_POLICY_PREEMPTIVE_PRIO || policy == SCHED_POLICY_MLFQ) {
         sched->priority_queues = malloc(sizeof(ProcessQueue*) * NUM_PRIORITY_LEVELS);
         if (!sched->priority_queues) {
             fprintf(stderr, "Failed to allocate priority queues array\n");
@@ -846,6 +1485,12 @@ Scheduler* create_scheduler_with_policy(int quantum, int policy, int sync_mode,
             queue_capacity = 2;
         }
         
+        // MLFQ: every process enters at level 0 and a boost can bring them all
+        // back there, so each level can hold the whole ready queue
+        if (policy == SCHED_POLICY_MLFQ) {
+            queue_capacity = ready_queue->max_capacity;
+        }
+        
         for (int i = 0; i < NUM_PRIORITY_LEVELS; i++) {
             sched->priority_queues[i] = create_process_queue(queue_capacity);
             if (!sched->priority_queues[i]) {
@@ -869,18 +1514,29 @@ void start_scheduler(Scheduler* sched) {
     if (!sched || sched->running) return;
     
     sched->running = 1;
+    
+    // In CLOCK mode the scheduler is a tick barrier participant: the clock waits for it
+    // every tick. Join before the thread exists so no tick goes by without it.
+    pthread_mutex_lock(&clk_mutex);
+    if (sched->sync_mode == SCHED_SYNC_CLOCK) {
+        sched->barrier_id = clock_join_tick_barrier("Scheduler", &sched->registered_tick);
+    }
     int ret = pthread_create(&sched->thread, NULL, scheduler_function, sched);
+    if (ret != 0 && sched->sync_mode == SCHED_SYNC_CLOCK) {
+        clock_leave_tick_barrier(sched->barrier_id);
+    }
+    pthread_mutex_unlock(&clk_mutex);
+    
     if (ret != 0) {
         fprintf(stderr, "Error creating scheduler thread: %s\n", strerror(ret));
         sched->running = 0;
     } else {
-        const char* policy_names[] = {"Round Robin", "BFS", "Preemptive Priority"};
         const char* sync_names[] = {"Global Clock", "Timer"};
         
-        printf("[Scheduler] Started with:\n");
-        printf("  - Quantum: %d ticks\n", sched->quantum);
-        printf("  - Policy: %s\n", policy_names[sched->policy]);
-        printf("  - Sync: %s\n", sync_names[sched->sync_mode]);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "[Scheduler] Started with:\n");
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Quantum: %d ticks\n", sched->quantum);
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Policy: %s\n", scheduler_policy_name(sched->policy));
+        LOG_PRINTF(LOG_LEVEL_SUMMARY, "  - Sync: %s\n", sync_names[sched->sync_mode]);
     }
 }
 
@@ -891,8 +1547,14 @@ void stop_scheduler(Scheduler* sched) {
     pthread_mutex_lock(&clk_mutex);
     sched->running = 0;
     pthread_cond_broadcast(&clk_cond);  // Wake up the scheduler
+    pthread_cond_broadcast(&clk_idle_cond);
     pthread_mutex_unlock(&clk_mutex);
     
+    // TIMER mode: wake up the scheduler and any timer waiting for it
+    pthread_mutex_lock(&sched->sched_mutex);
+    pthread_cond_broadcast(&sched->sched_cond);
+    pthread_mutex_unlock(&sched->sched_mutex);
+    
     pthread_join(sched->thread, NULL);
 }
 
@@ -918,6 +1580,57 @@ void destroy_scheduler(Scheduler* sched) {
             free(sched->priority_queues);
         }
         
+        // Free the processes left in the local run queues
+        if (sched->local_queues) {
+            for (int c = 0; c < sched->num_local_queues; c++) {
+                PCB* pcb;
+                while ((pcb = dequeue_process(sched->local_queues[c].queue)) != NULL) {
+                    destroy_pcb(pcb);
+                }
+                destroy_process_queue(sched->local_queues[c].queue);
+                pthread_mutex_destroy(&sched->local_queues[c].lock);
+            }
+            free(sched->local_queues);
+        }
+        
+        // Free the processes left in the CFS tree
+        while (sched->cfs_tree.leftmost) {
+            PCB* pcb = rb_entry(sched->cfs_tree.leftmost, PCB, run_node);
+            rb_erase(&sched->cfs_tree, &pcb->run_node);
+            destroy_pcb(pcb);
+        }
+        
+        // Free the processes left in the MuQSS run queues
+        if (sched->muqss_queues) {
+            for (int c = 0; c < sched->num_local_queues; c++) {
+                PCB* pcb;
+                while ((pcb = skip_list_pop(sched->muqss_queues[c].list)) != NULL) {
+                    destroy_pcb(pcb);
+                }
+                destroy_skip_list(sched->muqss_queues[c].list);
+                pthread_mutex_destroy(&sched->muqss_queues[c].lock);
+            }
+            free(sched->muqss_queues);
+        }
+        
+        // Free the processes left in the BFS deadline queue
+        if (sched->bfs_queue) {
+            PCB* pcb;
+            while ((pcb = run_queue_pop(sched->bfs_queue)) != NULL) {
+                destroy_pcb(pcb);
+            }
+            destroy_run_queue(sched->bfs_queue);
+        }
+        
+        // Free the processes left in the SRPT queue
+        if (sched->srpt_queue) {
+            PCB* pcb;
+            while ((pcb = run_queue_pop(sched->srpt_queue)) != NULL) {
+                destroy_pcb(pcb);
+            }
+            destroy_run_queue(sched->srpt_queue);
+        }
+        
         // Destroy mutex and condition variable
         pthread_mutex_destroy(&sched->sched_mutex);
         pthread_cond_destroy(&sched->sched_cond);
@@ -3,6 +3,7 @@
 
 #include <pthread.h>
 #include <stdint.h>
+#include "runqueue.h"
 
 // Global flag to control system execution
 extern volatile int running;
@@ -21,6 +22,10 @@ typedef struct Scheduler Scheduler;
 #define MAX_PRIORITY 19   // Lowest priority
 #define NUM_PRIORITY_LEVELS 40  // From -20 to 19
 
+#if NUM_PRIORITY_LEVELS > 64
+#error "The priority bitmap of the scheduler holds at most 64 levels"
+#endif
+
 // Memory Management structure for each process
 typedef struct {
     void* code;             // Virtual address of code segment start
@@ -44,6 +49,15 @@ typedef struct {
     int initial_ttl;        // Initial TTL value (for reset)
     int quantum_counter;    // Current quantum usage
     int virtual_deadline;   // Virtual deadline for BFS scheduling
+    int last_slot;          // Hardware thread it last ran on (-1 = never ran), for affinity
+    int arrival_tick;       // Tick it was created (turnaround = completion - arrival)
+    int mlfq_level;         // MLFQ: current level (0 = top), lowered on every full quantum
+    unsigned long long vruntime;  // CFS: run time weighted by its nice value
+    int timeslice;          // CFS: ticks it may run this time
+    int exec_start;         // CFS: tick it was put on a hardware thread
+    RBNode run_node;        // CFS: node in the run queue tree
+    unsigned long retired_instructions;  // Instructions executed (TTL and quantum count ticks)
+    unsigned long total_instructions;    // Instructions it executes to EXIT, from the loader (0 = unknown)
     MemoryManagement mm;    // Memory management information
     ExecutionContext context;  // Saved execution context
     // etc - extend as needed
@@ -72,17 +86,50 @@ typedef struct {
     volatile int running;    // Flag to control generator execution
     volatile int next_pid;   // Next process ID to assign
     volatile int total_generated; // Total processes generated
+    int registered_tick;     // Tick at which it joined the tick barrier
+    int barrier_id;          // Its participant id in the tick barrier
 } ProcessGenerator;
 
 // Scheduler policies
 #define SCHED_POLICY_ROUND_ROBIN 0      // Round robin sin prioridades (default)
 #define SCHED_POLICY_BFS 1              // Brain Fuck Scheduler
 #define SCHED_POLICY_PREEMPTIVE_PRIO 2  // Expulsora por evento con prioridades estáticas
+#define SCHED_POLICY_RR_LOCAL 3         // Round robin con colas por core y robo de trabajo
+#define SCHED_POLICY_MUQSS 4            // MuQSS: colas por core ordenadas por deadline virtual
+#define SCHED_POLICY_CFS 5              // Completely Fair Scheduler: árbol rojo-negro por vruntime
+#define SCHED_POLICY_MLFQ 6             // Colas multinivel realimentadas con boost periódico
+#define SCHED_POLICY_SRPT 7             // Menor trabajo restante primero (instrucciones del loader)
+#define SCHED_NUM_POLICIES 8
+
+// CFS: the -q quantum is the minimum granularity; the target latency is the
+// period in which every runnable process should run once
+#define CFS_NICE_0_WEIGHT 1024
+extern int CFS_TARGET_LATENCY;  // Ticks
+
+// MLFQ: level l has a quantum of (l + 1) * quantum; every MLFQ_BOOST_INTERVAL
+// ticks all processes go back to level 0 (0 = never)
+extern int MLFQ_BOOST_INTERVAL;
 
 // Scheduler synchronization modes
 #define SCHED_SYNC_CLOCK 0    // Sincronizado con el reloj global
 #define SCHED_SYNC_TIMER 1    // Sincronizado con un timer
 
+// Local run queue of one core (SCHED_POLICY_RR_LOCAL)
+typedef struct {
+    ProcessQueue* queue;   // FIFO: the core takes from the head, thieves from the tail
+    pthread_mutex_t lock;  // Protects this queue only
+    volatile int length;   // Processes in the queue, read without the lock
+    unsigned long stolen;  // Processes other cores took from it
+} LocalRunQueue;
+
+// Deadline run queue of one core (SCHED_POLICY_MUQSS)
+typedef struct {
+    SkipList* list;              // Processes ordered by virtual deadline
+    pthread_mutex_t lock;        // Protects the list
+    volatile int head_deadline;  // Deadline of the first process (INT_MAX if empty), read without the lock
+    unsigned long stolen;        // Processes other cores took from it
+} MuqssRunQueue;
+
 // Scheduler configuration
 typedef struct Scheduler {
     int quantum;                     // Quantum (max ticks per process)
@@ -90,13 +137,42 @@ typedef struct Scheduler {
     int sync_mode;                   // Modo de sincronización (CLOCK o TIMER)
     void* sync_source;               // Timer* si sync_mode==TIMER, NULL si CLOCK
     ProcessQueue* ready_queue;       // Queue of ready processes (for RR and BFS)
-    ProcessQueue** priority_queues;  // Array of queues for priority scheduling (one per priority level)
+    ProcessQueue** priority_queues;  // Array of queues for priority scheduling (one per priority level, MLFQ: per level)
+    uint64_t prio_bitmap;            // Bit i set while priority_queues[i] is not empty
+    int prio_count;                  // Processes in all priority queues
+    RunQueue* bfs_queue;             // BFS: processes ordered by virtual deadline (ready_queue is its inbox)
+    RunQueue* srpt_queue;            // SRPT: processes ordered by remaining instructions (ready_queue is its inbox)
+    LocalRunQueue* local_queues;     // RR_LOCAL: one run queue per core (ready_queue is their inbox)
+    MuqssRunQueue* muqss_queues;     // MUQSS: one deadline queue per core (ready_queue is their inbox)
+    int num_local_queues;            // Per-core queues (RR_LOCAL and MUQSS)
+    int next_local_queue;            // Core that gets the next new process
+    volatile int local_count;        // Processes in all per-core queues
+    volatile int dispatch_pending;   // The cores must pick from their queues in the next tick
+    unsigned long steals;            // Processes run by a core other than their queue's
+    RBTree cfs_tree;                 // CFS: runnable processes ordered by vruntime (ready_queue is its inbox)
+    unsigned long long min_vruntime; // CFS: vruntime given to new processes, never decreases
+    unsigned long cfs_load;          // CFS: weight of the processes in the tree or running
+    int cfs_running;                 // CFS: processes in the tree or running
+    int next_boost;                  // MLFQ: tick of the next priority boost
+    unsigned long boosts;            // MLFQ: boosts that moved some process
+    long long turnaround_total;      // Sum of the turnaround of the completed processes (ticks)
+    unsigned long picks;             // Processes taken from the run queues
+    long long pick_ns_total;         // Host time spent picking them
+    long long pick_ns_max;
+    unsigned long global_lock_acquired;   // clk_mutex taken by the scheduler
+    unsigned long global_lock_contended;  // ... and found held by another thread
+    unsigned long queue_lock_acquired;    // Per-core queue locks taken
+    unsigned long queue_lock_contended;   // ... found held (steals skip the queue)
     Machine* machine;                // Machine with CPUs and cores
     pthread_t thread;                // Scheduler thread
     volatile int running;            // Flag to control scheduler execution
     volatile int total_completed;    // Total processes completed
     pthread_mutex_t sched_mutex;     // Mutex for scheduler activation
     pthread_cond_t sched_cond;       // Condition variable for scheduler activation
+    unsigned long activations;       // Timer activations requested (TIMER sync)
+    unsigned long activations_done;  // Timer activations handled
+    int registered_tick;             // Tick at which it joined the tick barrier (CLOCK sync)
+    int barrier_id;                  // Its participant id in the tick barrier (CLOCK sync)
 } Scheduler;
 
 // PCB management
@@ -113,6 +189,7 @@ ProcessQueue* create_process_queue(int capacity);
 void destroy_process_queue(ProcessQueue* pq);
 int enqueue_process(ProcessQueue* pq, PCB* pcb);
 PCB* dequeue_process(ProcessQueue* pq);
+PCB* dequeue_process_tail(ProcessQueue* pq);  // Newest process (work stealing)
 
 // Process Generator
 ProcessGenerator* create_process_generator(int min_interval, int max_interval, 
@@ -135,9 +212,15 @@ void stop_scheduler(Scheduler* sched);
 void destroy_scheduler(Scheduler* sched);
 void* scheduler_function(void* arg);
 
+const char* scheduler_policy_name(int policy);
+int scheduler_policy_uses_priority(int policy);  // Priority shown in traces
+
 // Preemptive priority helper functions
-int get_lowest_priority_executing(Machine* machine, int* cpu_idx, int* core_idx, int* thread_idx);
 void preempt_lower_priority_processes(Scheduler* sched, PCB* new_pcb);
 int count_processes_in_priority_queues(Scheduler* sched);
+int scheduler_has_pending_work(Scheduler* sched);  // Processes executing or ready
+int scheduler_take_dispatch(Scheduler* sched);      // Per-core queues: do the cores pick this tick?
+void scheduler_dispatch_core(Scheduler* sched, int core_id);  // Per-core queues: pick for one core
+void scheduler_notify_work(Scheduler* sched);       // Wake it from tickless idle
 
 #endif // PROCESS_H
@@ -0,0 +1,425 @@
+#include "runqueue.h"
+#include <stdlib.h>
+
+// Does entry a go before entry b?
+static int run_queue_before(const RunQueueEntry* a, const RunQueueEntry* b) {
+    if (a->key != b->key) return a->key < b->key;
+    return a->seq < b->seq;
+}
+
+// Restore the heap property from position i upwards
+static void run_queue_sift_up(RunQueue* rq, int i) {
+    RunQueueEntry entry = rq->entries[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!run_queue_before(&entry, &rq->entries[parent])) break;
+        rq->entries[i] = rq->entries[parent];
+        i = parent;
+    }
+    rq->entries[i] = entry;
+}
+
+// Restore the heap property from position i downwards
+static void run_queue_sift_down(RunQueue* rq, int i) {
+    RunQueueEntry entry = rq->entries[i];
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= rq->size) break;
+        if (child + 1 < rq->size && run_queue_before(&rq->entries[child + 1], &rq->entries[child])) child++;
+        if (!run_queue_before(&rq->entries[child], &entry)) break;
+        rq->entries[i] = rq->entries[child];
+        i = child;
+    }
+    rq->entries[i] = entry;
+}
+
+// Create an empty run queue with room for 'capacity' processes
+RunQueue* create_run_queue(int capacity) {
+    if (capacity < 1) return NULL;
+
+    RunQueue* rq = malloc(sizeof(RunQueue));
+    if (!rq) return NULL;
+
+    rq->entries = malloc(capacity * sizeof(RunQueueEntry));
+    if (!rq->entries) {
+        free(rq);
+        return NULL;
+    }
+    rq->size = 0;
+    rq->capacity = capacity;
+    rq->next_seq = 0;
+    return rq;
+}
+
+// Free the run queue (not the items still in it)
+void destroy_run_queue(RunQueue* rq) {
+    if (rq) {
+        free(rq->entries);
+        free(rq);
+    }
+}
+
+// Insert an item. Returns 0 on success, -1 if the queue is full
+int run_queue_push(RunQueue* rq, void* item, int key) {
+    if (rq->size >= rq->capacity) return -1;
+
+    rq->entries[rq->size].key = key;
+    rq->entries[rq->size].seq = rq->next_seq++;
+    rq->entries[rq->size].item = item;
+    rq->size++;
+    run_queue_sift_up(rq, rq->size - 1);
+    return 0;
+}
+
+// Remove and return the item with the lowest key (the oldest one on ties)
+void* run_queue_pop(RunQueue* rq) {
+    if (rq->size == 0) return NULL;
+
+    void* item = rq->entries[0].item;
+    rq->size--;
+    if (rq->size > 0) {
+        rq->entries[0] = rq->entries[rq->size];
+        run_queue_sift_down(rq, 0);
+    }
+    return item;
+}
+
+// i-th item in heap order, NULL if out of range
+void* run_queue_item(RunQueue* rq, int i) {
+    if (i < 0 || i >= rq->size) return NULL;
+    return rq->entries[i].item;
+}
+
+// ============================================================================
+// Skip list
+// ============================================================================
+
+// Does node a go before (key, seq)?
+static int skip_list_before(const SkipListNode* a, int key, unsigned long seq) {
+    if (a->key != key) return a->key < key;
+    return a->seq < seq;
+}
+
+// Level of a new node: each extra level with probability 1/4 (xorshift32)
+static int skip_list_random_level(SkipList* sl) {
+    int level = 1;
+    while (level < SKIP_LIST_MAX_LEVEL) {
+        unsigned int x = sl->rand_state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        sl->rand_state = x;
+        if (x & 3) break;
+        level++;
+    }
+    return level;
+}
+
+// Create an empty skip list with room for 'capacity' processes
+SkipList* create_skip_list(int capacity) {
+    if (capacity < 1) return NULL;
+
+    SkipList* sl = malloc(sizeof(SkipList));
+    if (!sl) return NULL;
+
+    sl->nodes = malloc(capacity * sizeof(SkipListNode));
+    if (!sl->nodes) {
+        free(sl);
+        return NULL;
+    }
+    for (int i = 0; i < capacity; i++) {
+        sl->nodes[i].next[0] = (i + 1 < capacity) ? &sl->nodes[i + 1] : NULL;
+    }
+    sl->free_nodes = &sl->nodes[0];
+    for (int l = 0; l < SKIP_LIST_MAX_LEVEL; l++) {
+        sl->head.next[l] = NULL;
+    }
+    sl->head.level = SKIP_LIST_MAX_LEVEL;
+    sl->level = 1;
+    sl->size = 0;
+    sl->capacity = capacity;
+    sl->next_seq = 0;
+    sl->rand_state = 2463534242u;
+    return sl;
+}
+
+// Free the skip list (not the items still in it)
+void destroy_skip_list(SkipList* sl) {
+    if (sl) {
+        free(sl->nodes);
+        free(sl);
+    }
+}
+
+// Insert an item behind the ones with the same key. Returns 0 on success, -1 if full
+int skip_list_insert(SkipList* sl, void* item, int key) {
+    if (!sl->free_nodes) return -1;
+
+    SkipListNode* node = sl->free_nodes;
+    sl->free_nodes = node->next[0];
+    node->key = key;
+    node->seq = sl->next_seq++;
+    node->item = item;
+    node->level = skip_list_random_level(sl);
+    if (node->level > sl->level) sl->level = node->level;
+
+    // Walk down from the top level, linking the node in at each of its levels
+    SkipListNode* x = &sl->head;
+    for (int l = sl->level - 1; l >= 0; l--) {
+        while (x->next[l] && skip_list_before(x->next[l], key, node->seq)) {
+            x = x->next[l];
+        }
+        if (l < node->level) {
+            node->next[l] = x->next[l];
+            x->next[l] = node;
+        }
+    }
+    sl->size++;
+    return 0;
+}
+
+// Remove and return the first item (the oldest one on ties)
+void* skip_list_pop(SkipList* sl) {
+    SkipListNode* node = sl->head.next[0];
+    if (!node) return NULL;
+
+    // The first node is the first one at every level it is linked in
+    for (int l = 0; l < node->level; l++) {
+        sl->head.next[l] = node->next[l];
+    }
+    while (sl->level > 1 && !sl->head.next[sl->level - 1]) {
+        sl->level--;
+    }
+    sl->size--;
+
+    void* item = node->item;
+    node->next[0] = sl->free_nodes;
+    sl->free_nodes = node;
+    return item;
+}
+
+// ============================================================================
+// Red-black tree
+// ============================================================================
+
+// Rotate x down to the left, its right child takes its place
+static void rb_rotate_left(RBTree* t, RBNode* x) {
+    RBNode* y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) t->root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+// Rotate x down to the right, its left child takes its place
+static void rb_rotate_right(RBTree* t, RBNode* x) {
+    RBNode* y = x->left;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) t->root = y;
+    else if (x == x->parent->right) x->parent->right = y;
+    else x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+// Initialize an empty tree
+void rb_tree_init(RBTree* t) {
+    t->root = NULL;
+    t->leftmost = NULL;
+    t->size = 0;
+}
+
+// Insert a node after the ones that do not go after it
+void rb_insert(RBTree* t, RBNode* node, rb_before_fn before) {
+    RBNode* parent = NULL;
+    RBNode** link = &t->root;
+    int leftmost = 1;
+
+    while (*link) {
+        parent = *link;
+        if (before(node, parent)) {
+            link = &parent->left;
+        } else {
+            link = &parent->right;
+            leftmost = 0;
+        }
+    }
+    node->parent = parent;
+    node->left = node->right = NULL;
+    node->red = 1;
+    *link = node;
+    if (leftmost) t->leftmost = node;
+    t->size++;
+
+    // Restore the colors: no red node with a red parent, root black
+    RBNode* p;
+    while ((p = node->parent) && p->red) {
+        RBNode* g = p->parent;  // Exists: a red node is never the root
+        if (p == g->left) {
+            RBNode* u = g->right;
+            if (u && u->red) {
+                p->red = 0;
+                u->red = 0;
+                g->red = 1;
+                node = g;
+                continue;
+            }
+            if (node == p->right) {
+                rb_rotate_left(t, p);
+                node = p;
+                p = node->parent;
+            }
+            p->red = 0;
+            g->red = 1;
+            rb_rotate_right(t, g);
+        } else {
+            RBNode* u = g->left;
+            if (u && u->red) {
+                p->red = 0;
+                u->red = 0;
+                g->red = 1;
+                node = g;
+                continue;
+            }
+            if (node == p->left) {
+                rb_rotate_right(t, p);
+                node = p;
+                p = node->parent;
+            }
+            p->red = 0;
+            g->red = 1;
+            rb_rotate_left(t, g);
+        }
+    }
+    t->root->red = 0;
+}
+
+// Restore the black heights after removing a black node. 'node' (maybe NULL)
+// took its place under 'parent'
+static void rb_erase_fixup(RBTree* t, RBNode* node, RBNode* parent) {
+    while ((!node || !node->red) && node != t->root) {
+        if (parent->left == node) {
+            RBNode* other = parent->right;
+            if (other->red) {
+                other->red = 0;
+                parent->red = 1;
+                rb_rotate_left(t, parent);
+                other = parent->right;
+            }
+            if ((!other->left || !other->left->red) && (!other->right || !other->right->red)) {
+                other->red = 1;
+                node = parent;
+                parent = node->parent;
+            } else {
+                if (!other->right || !other->right->red) {
+                    other->left->red = 0;
+                    other->red = 1;
+                    rb_rotate_right(t, other);
+                    other = parent->right;
+                }
+                other->red = parent->red;
+                parent->red = 0;
+                other->right->red = 0;
+                rb_rotate_left(t, parent);
+                node = t->root;
+                break;
+            }
+        } else {
+            RBNode* other = parent->left;
+            if (other->red) {
+                other->red = 0;
+                parent->red = 1;
+                rb_rotate_right(t, parent);
+                other = parent->left;
+            }
+            if ((!other->left || !other->left->red) && (!other->right || !other->right->red)) {
+                other->red = 1;
+                node = parent;
+                parent = node->parent;
+            } else {
+                if (!other->left || !other->left->red) {
+                    other->right->red = 0;
+                    other->red = 1;
+                    rb_rotate_left(t, other);
+                    other = parent->left;
+                }
+                other->red = parent->red;
+                parent->red = 0;
+                other->left->red = 0;
+                rb_rotate_right(t, parent);
+                node = t->root;
+                break;
+            }
+        }
+    }
+    if (node) node->red = 0;
+}
+
+// Remove a node from the tree
+void rb_erase(RBTree* t, RBNode* node) {
+    RBNode* child;
+    RBNode* parent;
+    int red;
+
+    if (t->leftmost == node) t->leftmost = rb_next(node);
+    t->size--;
+
+    if (node->left && node->right) {
+        // Two children: its successor (leftmost of the right subtree) takes its place
+        RBNode* old = node;
+        node = node->right;
+        while (node->left) node = node->left;
+
+        if (!old->parent) t->root = node;
+        else if (old->parent->left == old) old->parent->left = node;
+        else old->parent->right = node;
+
+        child = node->right;
+        parent = node->parent;
+        red = node->red;
+        if (parent == old) {
+            parent = node;
+        } else {
+            if (child) child->parent = parent;
+            parent->left = child;
+            node->right = old->right;
+            old->right->parent = node;
+        }
+        node->parent = old->parent;
+        node->red = old->red;
+        node->left = old->left;
+        old->left->parent = node;
+
+        if (!red) rb_erase_fixup(t, child, parent);
+        return;
+    }
+
+    child = node->left ? node->left : node->right;
+    parent = node->parent;
+    red = node->red;
+    if (child) child->parent = parent;
+    if (!parent) t->root = child;
+    else if (parent->left == node) parent->left = child;
+    else parent->right = child;
+
+    if (!red) rb_erase_fixup(t, child, parent);
+}
+
+// Next node in order, NULL after the last one
+RBNode* rb_next(RBNode* node) {
+    if (node->right) {
+        node = node->right;
+        while (node->left) node = node->left;
+        return node;
+    }
+    while (node->parent && node == node->parent->right) {
+        node = node->parent;
+    }
+    return node->parent;
+}
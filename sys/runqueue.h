@@ -0,0 +1,85 @@
+#ifndef RUNQUEUE_H
+#define RUNQUEUE_H
+
+#include <stddef.h>
+
+// Entry of the run queue: key plus arrival order (ties are served FIFO)
+typedef struct {
+    int key;
+    unsigned long seq;
+    void* item;
+} RunQueueEntry;
+
+// Min-heap of processes ordered by (key, arrival order). Used by BFS with the
+// virtual deadline as key: insert and pick-min are O(log n)
+typedef struct {
+    RunQueueEntry* entries;
+    int size;
+    int capacity;
+    unsigned long next_seq;  // Arrival counter for the FIFO tie-break
+} RunQueue;
+
+// Skip list node: key plus arrival order, like the heap entries
+#define SKIP_LIST_MAX_LEVEL 16
+typedef struct SkipListNode {
+    int key;
+    unsigned long seq;
+    void* item;
+    int level;                                    // Levels this node is linked in
+    struct SkipListNode* next[SKIP_LIST_MAX_LEVEL];
+} SkipListNode;
+
+// Skip list of processes ordered by (key, arrival order). Used by MuQSS with the
+// virtual deadline as key: insert is O(log n) and the first item is always the
+// head, so pick-min and peeking the earliest key are O(1)
+typedef struct {
+    SkipListNode head;          // Sentinel, head.next[0] is the first node
+    SkipListNode* nodes;        // Preallocated nodes (capacity)
+    SkipListNode* free_nodes;   // Unused nodes, linked through next[0]
+    int level;                  // Highest level in use
+    int size;
+    int capacity;
+    unsigned long next_seq;     // Arrival counter for the FIFO tie-break
+    unsigned int rand_state;    // Private generator for node levels (rand() is left alone)
+} SkipList;
+
+// Red-black tree node, embedded in the item it orders (intrusive: no allocation)
+typedef struct RBNode {
+    struct RBNode* parent;
+    struct RBNode* left;
+    struct RBNode* right;
+    int red;
+} RBNode;
+
+// Red-black tree. Used by CFS with the virtual runtime as key: insert and
+// erase are O(log n), the cached leftmost node makes pick-min O(1)
+typedef struct {
+    RBNode* root;
+    RBNode* leftmost;  // First node in order, NULL if empty
+    int size;
+} RBTree;
+
+// Does node a go before node b? Equal nodes are inserted after the existing ones
+typedef int (*rb_before_fn)(const RBNode* a, const RBNode* b);
+
+// Item that embeds a node
+#define rb_entry(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+
+// Function declarations
+RunQueue* create_run_queue(int capacity);
+void destroy_run_queue(RunQueue* rq);
+int run_queue_push(RunQueue* rq, void* item, int key);  // 0 on success, -1 if full
+void* run_queue_pop(RunQueue* rq);  // Item with the lowest key, NULL if empty
+void* run_queue_item(RunQueue* rq, int i);  // i-th item in heap order (for listings)
+
+SkipList* create_skip_list(int capacity);
+void destroy_skip_list(SkipList* sl);
+int skip_list_insert(SkipList* sl, void* item, int key);  // 0 on success, -1 if full
+void* skip_list_pop(SkipList* sl);  // First item (lowest key), NULL if empty
+
+void rb_tree_init(RBTree* t);
+void rb_insert(RBTree* t, RBNode* node, rb_before_fn before);
+void rb_erase(RBTree* t, RBNode* node);
+RBNode* rb_next(RBNode* node);  // Next node in order, NULL at the end
+
+#endif // RUNQUEUE_H
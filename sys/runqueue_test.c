@@ -0,0 +1,204 @@
+#include "runqueue.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Test driver for the run queues: red-black tree (CFS), heap (BFS, SRPT) and
+// skip list (MuQSS). Random operations against a reference, with a fixed seed
+// unless one is given: ./runqueue_test [seed]
+
+#define TEST_ITEMS 512
+#define TEST_OPERATIONS 20000
+#define TEST_KEYS 64  // Few distinct keys: many ties to check the FIFO order
+
+typedef struct {
+    int key;
+    unsigned long seq;  // Insertion order, for the FIFO tie-break
+    int queued;
+    RBNode node;
+} TestItem;
+
+static unsigned int test_state;
+static int failures = 0;
+
+// Private generator, the same sequence on every platform
+static unsigned int test_rand(void) {
+    test_state = test_state * 1103515245u + 12345u;
+    return (test_state >> 16) & 0x7fff;
+}
+
+static void test_fail(const char* structure, int op, const char* what) {
+    if (failures++ < 10) {
+        fprintf(stderr, "runqueue_test: %s, operation %d: %s\n", structure, op, what);
+    }
+}
+
+// Does item a go before item b? Key, then insertion order
+static int item_before(const TestItem* a, const TestItem* b) {
+    if (a->key != b->key) return a->key < b->key;
+    return a->seq < b->seq;
+}
+
+static int rb_item_before(const RBNode* a, const RBNode* b) {
+    return rb_entry(a, TestItem, node)->key < rb_entry(b, TestItem, node)->key;
+}
+
+// First queued item of the reference, NULL if none
+static TestItem* reference_min(TestItem* items) {
+    TestItem* min = NULL;
+    for (int i = 0; i < TEST_ITEMS; i++) {
+        if (items[i].queued && (!min || item_before(&items[i], min))) min = &items[i];
+    }
+    return min;
+}
+
+// Check the subtree of node: parent links, no red node with a red child and
+// the same black height on every path. Returns the black height, -1 on error
+static int rb_check_subtree(const RBNode* node, const RBNode* parent) {
+    if (!node) return 1;
+    if (node->parent != parent) return -1;
+    if (node->red && ((node->left && node->left->red) || (node->right && node->right->red))) return -1;
+    int left = rb_check_subtree(node->left, node);
+    int right = rb_check_subtree(node->right, node);
+    if (left < 0 || right < 0 || left != right) return -1;
+    return left + !node->red;
+}
+
+// Check the whole tree against the reference
+static void rb_check(RBTree* t, TestItem* items, int op) {
+    if (t->root && t->root->red) test_fail("rbtree", op, "red root");
+    if (rb_check_subtree(t->root, NULL) < 0) test_fail("rbtree", op, "red-black invariants broken");
+
+    // In-order traversal from the leftmost node: sorted by key, equal keys FIFO
+    int count = 0;
+    const TestItem* prev = NULL;
+    for (RBNode* n = t->leftmost; n; n = rb_next(n)) {
+        const TestItem* item = rb_entry(n, TestItem, node);
+        if (!item->queued) test_fail("rbtree", op, "item not queued in the tree");
+        if (prev && !item_before(prev, item)) test_fail("rbtree", op, "in-order traversal out of order");
+        prev = item;
+        count++;
+    }
+
+    int queued = 0;
+    for (int i = 0; i < TEST_ITEMS; i++) queued += items[i].queued;
+    if (count != queued || t->size != queued) test_fail("rbtree", op, "size mismatch");
+
+    TestItem* min = reference_min(items);
+    if (t->leftmost != (min ? &min->node : NULL)) test_fail("rbtree", op, "wrong leftmost");
+    const RBNode* first = t->root;
+    while (first && first->left) first = first->left;
+    if (first != t->leftmost) test_fail("rbtree", op, "leftmost is not the first node");
+}
+
+// Red-black tree: insert and erase in random order
+static void test_rbtree(TestItem* items) {
+    RBTree tree;
+    rb_tree_init(&tree);
+    unsigned long seq = 0;
+
+    for (int op = 0; op < TEST_OPERATIONS; op++) {
+        TestItem* item = &items[test_rand() % TEST_ITEMS];
+        if (item->queued) {
+            rb_erase(&tree, &item->node);
+            item->queued = 0;
+        } else {
+            item->key = test_rand() % TEST_KEYS;
+            item->seq = seq++;
+            item->queued = 1;
+            rb_insert(&tree, &item->node, rb_item_before);
+        }
+        rb_check(&tree, items, op);
+    }
+
+    // Drain from the leftmost node: the CFS pick
+    while (tree.leftmost) {
+        TestItem* min = reference_min(items);
+        if (tree.leftmost != &min->node) test_fail("rbtree", -1, "drain out of order");
+        min->queued = 0;
+        rb_erase(&tree, tree.leftmost);
+    }
+    rb_check(&tree, items, -1);
+}
+
+// Heap and skip list: random pushes and pops, every pop must be the reference
+// minimum. Both queues run the same sequence
+static void test_queues(TestItem* items) {
+    RunQueue* heap = create_run_queue(TEST_ITEMS);
+    SkipList* list = create_skip_list(TEST_ITEMS);
+    if (!heap || !list) {
+        test_fail("setup", 0, "allocation failed");
+        destroy_run_queue(heap);
+        destroy_skip_list(list);
+        return;
+    }
+    unsigned long seq = 0;
+    int queued = 0;
+
+    for (int op = 0; op < TEST_OPERATIONS; op++) {
+        // Pushes slightly more likely, so the queues fill up and empty again
+        if (test_rand() % 100 < 55 || queued == 0) {
+            TestItem* item = &items[test_rand() % TEST_ITEMS];
+            if (item->queued) continue;
+            item->key = test_rand() % TEST_KEYS;
+            item->seq = seq++;
+            item->queued = 1;
+            queued++;
+            if (run_queue_push(heap, item, item->key) != 0) test_fail("heap", op, "push failed");
+            if (skip_list_insert(list, item, item->key) != 0) test_fail("skiplist", op, "insert failed");
+        } else {
+            TestItem* min = reference_min(items);
+            min->queued = 0;
+            queued--;
+            if (run_queue_pop(heap) != min) test_fail("heap", op, "pop is not the minimum (key, FIFO)");
+            if (skip_list_pop(list) != min) test_fail("skiplist", op, "pop is not the minimum (key, FIFO)");
+        }
+        if (heap->size != queued) test_fail("heap", op, "size mismatch");
+        if (list->size != queued) test_fail("skiplist", op, "size mismatch");
+    }
+
+    // Drain, then fill to capacity: one more push must be refused
+    while (queued > 0) {
+        TestItem* min = reference_min(items);
+        min->queued = 0;
+        queued--;
+        if (run_queue_pop(heap) != min) test_fail("heap", -1, "drain out of order");
+        if (skip_list_pop(list) != min) test_fail("skiplist", -1, "drain out of order");
+    }
+    if (run_queue_pop(heap) || skip_list_pop(list)) test_fail("queues", -1, "pop from an empty queue");
+    for (int i = 0; i < TEST_ITEMS; i++) {
+        run_queue_push(heap, &items[i], 0);
+        skip_list_insert(list, &items[i], 0);
+    }
+    if (run_queue_push(heap, &items[0], 0) != -1) test_fail("heap", -1, "push into a full queue");
+    if (skip_list_insert(list, &items[0], 0) != -1) test_fail("skiplist", -1, "insert into a full queue");
+    for (int i = 0; i < TEST_ITEMS; i++) {
+        if (run_queue_pop(heap) != &items[i]) test_fail("heap", -1, "equal keys not FIFO");
+        if (skip_list_pop(list) != &items[i]) test_fail("skiplist", -1, "equal keys not FIFO");
+    }
+
+    destroy_run_queue(heap);
+    destroy_skip_list(list);
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int seed = argc > 1 ? (unsigned int)strtoul(argv[1], NULL, 10) : 12345;
+    test_state = seed;
+
+    TestItem* items = calloc(TEST_ITEMS, sizeof(TestItem));
+    if (!items) {
+        fprintf(stderr, "runqueue_test: allocation failed\n");
+        return 1;
+    }
+
+    test_rbtree(items);
+    for (int i = 0; i < TEST_ITEMS; i++) items[i].queued = 0;
+    test_queues(items);
+    free(items);
+
+    if (failures > 0) {
+        fprintf(stderr, "runqueue_test: %d failures (seed %u)\n", failures, seed);
+        return 1;
+    }
+    printf("runqueue_test: red-black tree, heap and skip list OK (%d operations each)\n", TEST_OPERATIONS);
+    return 0;
+}
@@ -20,7 +20,7 @@ echo -e "${BLUE}========================================${NC}"
 echo ""
 
 # Compile the kernel first
-echo -e "${YELLOW}[1/16] Compilando el kernel...${NC}"
+echo -e "${YELLOW}[1/46] Compilando el kernel...${NC}"
 make clean > /dev/null 2>&1
 make > /dev/null 2>&1
 
@@ -36,7 +36,7 @@ echo ""
 # ============================================================
 
 # Test 1: Round Robin + Reloj Global
-echo -e "${YELLOW}[2/16] Test 1: Round Robin + Reloj Global${NC}"
+echo -e "${YELLOW}[2/46] Test 1: Round Robin + Reloj Global${NC}"
 echo "Parámetros: -q 5 -policy 0 -sync 0 -f 2"
 timeout $TEST_DURATION ./kernel -q 5 -policy 0 -sync 0 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -47,7 +47,7 @@ fi
 echo ""
 
 # Test 2: Round Robin + Timer
-echo -e "${YELLOW}[3/16] Test 2: Round Robin + Timer${NC}"
+echo -e "${YELLOW}[3/46] Test 2: Round Robin + Timer${NC}"
 echo "Parámetros: -q 8 -policy 0 -sync 1 -f 3"
 timeout $TEST_DURATION ./kernel -q 8 -policy 0 -sync 1 -f 3 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -58,7 +58,7 @@ fi
 echo ""
 
 # Test 3: BFS + Reloj Global
-echo -e "${YELLOW}[4/16] Test 3: BFS + Reloj Global${NC}"
+echo -e "${YELLOW}[4/46] Test 3: BFS + Reloj Global${NC}"
 echo "Parámetros: -q 6 -policy 1 -sync 0 -f 2"
 timeout $TEST_DURATION ./kernel -q 6 -policy 1 -sync 0 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -69,7 +69,7 @@ fi
 echo ""
 
 # Test 4: BFS + Timer
-echo -e "${YELLOW}[5/16] Test 4: BFS + Timer${NC}"
+echo -e "${YELLOW}[5/46] Test 4: BFS + Timer${NC}"
 echo "Parámetros: -q 10 -policy 1 -sync 1 -f 2"
 timeout $TEST_DURATION ./kernel -q 10 -policy 1 -sync 1 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -80,7 +80,7 @@ fi
 echo ""
 
 # Test 5: Prioridades + Reloj Global
-echo -e "${YELLOW}[6/16] Test 5: Prioridades + Reloj Global${NC}"
+echo -e "${YELLOW}[6/46] Test 5: Prioridades + Reloj Global${NC}"
 echo "Parámetros: -q 7 -policy 2 -sync 0 -f 2"
 timeout $TEST_DURATION ./kernel -q 7 -policy 2 -sync 0 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -91,7 +91,7 @@ fi
 echo ""
 
 # Test 6: Prioridades + Timer
-echo -e "${YELLOW}[7/16] Test 6: Prioridades + Timer${NC}"
+echo -e "${YELLOW}[7/46] Test 6: Prioridades + Timer${NC}"
 echo "Parámetros: -q 12 -policy 2 -sync 1 -f 2"
 timeout $TEST_DURATION ./kernel -q 12 -policy 2 -sync 1 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -106,7 +106,7 @@ echo ""
 # ============================================================
 
 # Test 7: Quantum pequeño
-echo -e "${YELLOW}[8/16] Test 7: Round Robin - Quantum Pequeño (2)${NC}"
+echo -e "${YELLOW}[8/46] Test 7: Round Robin - Quantum Pequeño (2)${NC}"
 echo "Parámetros: -q 2 -policy 0 -sync 0 -f 4"
 timeout $TEST_DURATION ./kernel -q 2 -policy 0 -sync 0 -f 4 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -117,7 +117,7 @@ fi
 echo ""
 
 # Test 8: Quantum grande
-echo -e "${YELLOW}[9/16] Test 8: BFS - Quantum Grande (25)${NC}"
+echo -e "${YELLOW}[9/46] Test 8: BFS - Quantum Grande (25)${NC}"
 echo "Parámetros: -q 25 -policy 1 -sync 1 -f 1"
 timeout $TEST_DURATION ./kernel -q 25 -policy 1 -sync 1 -f 1 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -128,7 +128,7 @@ fi
 echo ""
 
 # Test 9: Alta frecuencia
-echo -e "${YELLOW}[10/16] Test 9: Round Robin - Alta Frecuencia (10 Hz)${NC}"
+echo -e "${YELLOW}[10/46] Test 9: Round Robin - Alta Frecuencia (10 Hz)${NC}"
 echo "Parámetros: -q 3 -policy 0 -sync 0 -f 10"
 timeout $TEST_DURATION ./kernel -q 3 -policy 0 -sync 0 -f 10 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -139,7 +139,7 @@ fi
 echo ""
 
 # Test 10: Cola grande
-echo -e "${YELLOW}[11/16] Test 10: Prioridades - Cola Grande (150)${NC}"
+echo -e "${YELLOW}[11/46] Test 10: Prioridades - Cola Grande (150)${NC}"
 echo "Parámetros: -qsize 150 -policy 2 -sync 0 -f 3 -q 8"
 timeout $TEST_DURATION ./kernel -qsize 150 -policy 2 -sync 0 -f 3 -q 8 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -154,7 +154,7 @@ echo ""
 # ============================================================
 
 # Test 11: Multiprocesador - Round Robin
-echo -e "${YELLOW}[12/16] Test 11: Multiprocesador - Round Robin (2 CPUs, 4 cores)${NC}"
+echo -e "${YELLOW}[12/46] Test 11: Multiprocesador - Round Robin (2 CPUs, 4 cores)${NC}"
 echo "Parámetros: -cpus 2 -cores 4 -threads 2 -policy 0 -sync 1 -q 6 -f 3"
 timeout $TEST_DURATION ./kernel -cpus 2 -cores 4 -threads 2 -policy 0 -sync 1 -q 6 -f 3 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -165,7 +165,7 @@ fi
 echo ""
 
 # Test 12: Multiprocesador - BFS
-echo -e "${YELLOW}[13/16] Test 12: Multiprocesador - BFS (2 CPUs, 2 cores, 4 threads)${NC}"
+echo -e "${YELLOW}[13/46] Test 12: Multiprocesador - BFS (2 CPUs, 2 cores, 4 threads)${NC}"
 echo "Parámetros: -cpus 2 -cores 2 -threads 4 -policy 1 -sync 0 -q 8 -f 2"
 timeout $TEST_DURATION ./kernel -cpus 2 -cores 2 -threads 4 -policy 1 -sync 0 -q 8 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -176,7 +176,7 @@ fi
 echo ""
 
 # Test 13: Multiprocesador - Prioridades
-echo -e "${YELLOW}[14/16] Test 13: Multiprocesador - Prioridades (3 CPUs, 2 cores)${NC}"
+echo -e "${YELLOW}[14/46] Test 13: Multiprocesador - Prioridades (3 CPUs, 2 cores)${NC}"
 echo "Parámetros: -cpus 3 -cores 2 -threads 2 -policy 2 -sync 1 -q 10 -f 2"
 timeout $TEST_DURATION ./kernel -cpus 3 -cores 2 -threads 2 -policy 2 -sync 1 -q 10 -f 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -191,7 +191,7 @@ echo ""
 # ============================================================
 
 # Test 14: Estrés - Quantum mínimo + Alta frecuencia
-echo -e "${YELLOW}[15/16] Test 14: ESTRÉS - Quantum 1 + Frecuencia 15 Hz${NC}"
+echo -e "${YELLOW}[15/46] Test 14: ESTRÉS - Quantum 1 + Frecuencia 15 Hz${NC}"
 echo "Parámetros: -q 1 -policy 0 -sync 0 -f 15"
 timeout $TEST_DURATION ./kernel -q 1 -policy 0 -sync 0 -f 15 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -202,7 +202,7 @@ fi
 echo ""
 
 # Test 15: Estrés Total - Todo al máximo
-echo -e "${YELLOW}[16/16] Test 15: ESTRÉS TOTAL - Configuración Extrema${NC}"
+echo -e "${YELLOW}[16/46] Test 15: ESTRÉS TOTAL - Configuración Extrema${NC}"
 echo "Parámetros: -q 1 -policy 2 -sync 0 -f 20 -qsize 200 -cpus 4 -cores 2 -threads 2"
 timeout $TEST_DURATION ./kernel -q 1 -policy 2 -sync 0 -f 20 -qsize 200 -cpus 4 -cores 2 -threads 2 > /dev/null 2>&1
 if [ $? -eq 124 ]; then
@@ -212,21 +212,435 @@ else
 fi
 echo ""
 
+# ============================================================
+# TESTS DEL MOTOR DE EJECUCIÓN
+# ============================================================
+
+# Test 16: Ejecución paralela (un worker por core)
+echo -e "${YELLOW}[17/46] Test 16: Ejecución paralela (un worker por core)${NC}"
+echo "Parámetros: -cpus 2 -cores 4 -threads 2 -par 1 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -cpus 2 -cores 4 -threads 2 -par 1 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 17: Sin caché de instrucciones decodificadas
+echo -e "${YELLOW}[18/46] Test 17: Sin caché de instrucciones decodificadas${NC}"
+echo "Parámetros: -dcache 0 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -dcache 0 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 18: Intérprete switch clásico
+echo -e "${YELLOW}[19/46] Test 18: Intérprete switch clásico${NC}"
+echo "Parámetros: -interp 0 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -interp 0 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 19: JIT de bloques a x86-64
+echo -e "${YELLOW}[20/46] Test 19: JIT de bloques a x86-64${NC}"
+echo "Parámetros: -jit 1 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -jit 1 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 20: Superinstrucciones desactivadas
+echo -e "${YELLOW}[21/46] Test 20: Superinstrucciones desactivadas${NC}"
+echo "Parámetros: -fuse 0 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -fuse 0 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 21: Varias instrucciones por tick con límite por core
+echo -e "${YELLOW}[22/46] Test 21: Varias instrucciones por tick con límite por core${NC}"
+echo "Parámetros: -ipc 8 -corecap 12 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -ipc 8 -corecap 12 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 22: TLB asociativo por conjuntos con LRU
+echo -e "${YELLOW}[23/46] Test 22: TLB asociativo por conjuntos con LRU${NC}"
+echo "Parámetros: -dcache 0 -tlb 8 -tlbways 2 -tlbpolicy 1 -q 3 -f 5"
+timeout $TEST_DURATION ./kernel -dcache 0 -tlb 8 -tlbways 2 -tlbpolicy 1 -q 3 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 23: TLB sin ASID (vaciado en cada cambio de contexto)
+echo -e "${YELLOW}[24/46] Test 23: TLB sin ASID (vaciado en cada cambio de contexto)${NC}"
+echo "Parámetros: -asid 0 -dcache 0 -q 1 -f 5"
+timeout $TEST_DURATION ./kernel -asid 0 -dcache 0 -q 1 -f 5 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# TESTS DE SALIDA (LOG)
+# ============================================================
+
+# Test 24: Log resumido con reloj rápido
+echo -e "${YELLOW}[25/46] Test 24: Log resumido con reloj rápido${NC}"
+echo "Parámetros: -log summary -par 1 -f 1000"
+timeout $TEST_DURATION ./kernel -log summary -par 1 -f 1000 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 25: Reloj en tiempo virtual (sin límite de frecuencia)
+echo -e "${YELLOW}[26/46] Test 25: Reloj en tiempo virtual (sin límite de frecuencia)${NC}"
+echo "Parámetros: -f max -log summary -sync 1"
+timeout $TEST_DURATION ./kernel -f max -log summary -sync 1 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 26: Simulación por eventos (salto de ticks ociosos)
+echo -e "${YELLOW}[27/46] Test 26: Simulación por eventos (salto de ticks ociosos)${NC}"
+echo "Parámetros: -des 1 -f max -log summary -t 2"
+timeout $TEST_DURATION ./kernel -des 1 -f max -log summary -t 2 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 27: Reloj de alta frecuencia (plazos absolutos, 2 MHz)
+echo -e "${YELLOW}[28/46] Test 27: Reloj de alta frecuencia (plazos absolutos, 2 MHz)${NC}"
+echo "Parámetros: -f 2M -log summary"
+timeout $TEST_DURATION ./kernel -f 2M -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 28: Mil timers en la rueda de temporización
+echo -e "${YELLOW}[29/46] Test 28: Mil timers en la rueda de temporización${NC}"
+echo "Parámetros: -t 1000 -f max -log summary"
+timeout $TEST_DURATION ./kernel -t 1000 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 29: Barrera de tick con timeout
+echo -e "${YELLOW}[30/46] Test 29: Barrera de tick con timeout${NC}"
+echo "Parámetros: -tickto 50 -sync 1 -t 2 -f max -log summary"
+timeout $TEST_DURATION ./kernel -tickto 50 -sync 1 -t 2 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 30: Modo tickless (scheduler y timers en reposo)
+echo -e "${YELLOW}[31/46] Test 30: Modo tickless (scheduler y timers en reposo)${NC}"
+echo "Parámetros: -nohz 1 -t 2 -f 100 -log summary"
+timeout $TEST_DURATION ./kernel -nohz 1 -t 2 -f 100 -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 31: BFS con cola de listos grande
+echo -e "${YELLOW}[32/46] Test 31: BFS con cola de listos grande${NC}"
+echo "Parámetros: -policy 1 -qsize 5000 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 1 -qsize 5000 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 32: Prioridades con cola de listos grande
+echo -e "${YELLOW}[33/46] Test 32: Prioridades con cola de listos grande${NC}"
+echo "Parámetros: -policy 2 -qsize 5000 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 2 -qsize 5000 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 33: Prioridades con muchos hilos hardware
+echo -e "${YELLOW}[34/46] Test 33: Prioridades con muchos hilos hardware${NC}"
+echo "Parámetros: -policy 2 -cpus 4 -cores 4 -threads 8 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 2 -cpus 4 -cores 4 -threads 8 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 34: Hilos hardware al máximo (64 por core)
+echo -e "${YELLOW}[35/46] Test 34: Hilos hardware al máximo (64 por core)${NC}"
+echo "Parámetros: -cpus 2 -cores 2 -threads 64 -f max -log summary"
+timeout $TEST_DURATION ./kernel -cpus 2 -cores 2 -threads 64 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# Round Robin con colas por core
+# ============================================================
+
+# Test 35: RR por core con robo de trabajo
+echo -e "${YELLOW}[36/46] Test 35: RR por core con robo de trabajo${NC}"
+echo "Parámetros: -policy 3 -cpus 4 -cores 4 -threads 4 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 3 -cpus 4 -cores 4 -threads 4 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# Test 36: RR por core sincronizado con timer
+echo -e "${YELLOW}[37/46] Test 36: RR por core sincronizado con timer${NC}"
+echo "Parámetros: -policy 3 -sync 1 -cpus 2 -cores 2 -q 2 -f 50"
+timeout $TEST_DURATION ./kernel -policy 3 -sync 1 -cpus 2 -cores 2 -q 2 -f 50 > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# MuQSS
+# ============================================================
+
+# Test 37: MuQSS, colas por core con deadlines
+echo -e "${YELLOW}[38/46] Test 37: MuQSS, colas por core con deadlines${NC}"
+echo "Parámetros: -policy 4 -cpus 2 -cores 4 -threads 2 -q 3 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 4 -cpus 2 -cores 4 -threads 2 -q 3 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# Completely Fair Scheduler
+# ============================================================
+
+# Test 38: CFS con timeslice dinámico
+echo -e "${YELLOW}[39/46] Test 38: CFS con timeslice dinámico${NC}"
+echo "Parámetros: -policy 5 -cpus 2 -cores 2 -threads 2 -q 2 -cfslat 12 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 5 -cpus 2 -cores 2 -threads 2 -q 2 -cfslat 12 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# Multilevel Feedback Queue
+# ============================================================
+
+# Test 39: MLFQ con boost periódico
+echo -e "${YELLOW}[40/46] Test 39: MLFQ con boost periódico${NC}"
+echo "Parámetros: -policy 6 -cpus 1 -cores 2 -threads 2 -q 2 -boost 20 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 6 -cpus 1 -cores 2 -threads 2 -q 2 -boost 20 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# Shortest Remaining Processing Time
+# ============================================================
+
+# Test 40: SRPT + Timer con varios hilos
+echo -e "${YELLOW}[41/46] Test 40: SRPT + Timer con varios hilos${NC}"
+echo "Parámetros: -policy 7 -cpus 1 -cores 2 -threads 2 -q 2 -sync 1 -f max -log summary"
+timeout $TEST_DURATION ./kernel -policy 7 -cpus 1 -cores 2 -threads 2 -q 2 -sync 1 -f max -log summary > /dev/null 2>&1
+if [ $? -eq 124 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
+# ============================================================
+# TESTS DE TRAZAS (misma ejecución con otra configuración)
+# ============================================================
+
+# ../programs no tiene .elf en un checkout limpio: las trazas se comparan con
+# un conjunto fijo de programas (grupos LD/LD/ADD/ST y EXIT) generado aquí
+TRACE_PROGRAMS=12
+TRACE_KERNEL="$PWD/kernel"
+TRACE_DIR=$(mktemp -d)
+trap 'rm -rf "$TRACE_DIR"' EXIT
+mkdir -p "$TRACE_DIR/programs" "$TRACE_DIR/sys"
+for p in $(seq 0 $((TRACE_PROGRAMS - 1))); do
+    groups=$((1 + (p * 7) % 10))
+    data=$(( (groups * 4 + 1) * 4 ))
+    {
+        printf ".text 000000\n.data %06X\n" $data
+        for g in $(seq 0 $((groups - 1))); do
+            addr=$((data + g * 12))
+            printf "01%06X\n02%06X\n23120000\n13%06X\n" $addr $((addr + 4)) $((addr + 8))
+        done
+        echo "F0000000"
+        for g in $(seq 0 $((groups - 1))); do
+            printf "%08X\n%08X\n00000000\n" $((p + g)) $((2 * g + 1))
+        done
+    } > "$TRACE_DIR/programs/prog$(printf %02d $p).elf"
+done
+
+# Líneas de instrucciones, scheduler y timers hasta la tercera interrupción de
+# timer después del último programa (el kernel sigue hasta recibir SIGINT)
+traza() {
+    (cd "$TRACE_DIR/sys" && timeout -s INT $TEST_DURATION "$TRACE_KERNEL" -f max "$@" 2>/dev/null) |
+        grep -aE '^\[(Exec|Scheduler|Timer)\]' |
+        awk -v total=$TRACE_PROGRAMS '{ print } /COMPLETED/ { n++ } n == total && /^\[Timer\]/ && ++t == 3 { exit }'
+}
+
+# comparar_trazas "<flags comunes>" "<flags A>" "<flags B>": las dos trazas
+# deben ser idénticas y terminar todos los programas
+comparar_trazas() {
+    traza $1 $2 > "$TRACE_DIR/a.txt"
+    traza $1 $3 > "$TRACE_DIR/b.txt"
+    if [ "$(grep -c COMPLETED "$TRACE_DIR/a.txt")" -eq $TRACE_PROGRAMS ] &&
+       diff -q "$TRACE_DIR/a.txt" "$TRACE_DIR/b.txt" > /dev/null; then
+        echo -e "${GREEN}✓ Test completado${NC} ($(wc -l < "$TRACE_DIR/a.txt") líneas idénticas)"
+    else
+        echo -e "${RED}✗ Test falló${NC}"
+        diff "$TRACE_DIR/a.txt" "$TRACE_DIR/b.txt" | head -5
+    fi
+}
+
+# Test 41: Traza paralela idéntica a la serie
+echo -e "${YELLOW}[42/46] Test 41: Traza paralela idéntica a la serie${NC}"
+echo "Parámetros: -cpus 2 -cores 2 -threads 2 -ipc 3 -sync 1 -timeri 4, -par 0 frente a -par 1"
+comparar_trazas "-cpus 2 -cores 2 -threads 2 -ipc 3 -sync 1 -timeri 4" "-par 0" "-par 1"
+echo ""
+
+# Test 42: Simulación por eventos con la misma traza
+echo -e "${YELLOW}[43/46] Test 42: Simulación por eventos con la misma traza${NC}"
+echo "Parámetros: -cpus 1 -cores 2 -threads 2 -sync 1 -timeri 6, -des 0 frente a -des 1"
+comparar_trazas "-cpus 1 -cores 2 -threads 2 -sync 1 -timeri 6" "-des 0" "-des 1"
+echo ""
+
+# Test 43: Modo tickless con la misma traza
+echo -e "${YELLOW}[44/46] Test 43: Modo tickless con la misma traza${NC}"
+echo "Parámetros: -cpus 1 -cores 2 -threads 2 -sync 1 -timeri 6 -t 2, -nohz 0 frente a -nohz 1"
+comparar_trazas "-cpus 1 -cores 2 -threads 2 -sync 1 -timeri 6 -t 2" "-nohz 0" "-nohz 1"
+echo ""
+
+# Test 44: Límite por core menor que los hilos (se sube a uno por hilo)
+echo -e "${YELLOW}[45/46] Test 44: Límite por core menor que los hilos${NC}"
+echo "Parámetros: -cpus 1 -cores 1 -threads 4 -corecap 2 -sync 1, todos los programas deben llegar a EXIT"
+traza -cpus 1 -cores 1 -threads 4 -corecap 2 -sync 1 > "$TRACE_DIR/a.txt"
+if [ "$(grep -c 'COMPLETED (EXIT' "$TRACE_DIR/a.txt")" -eq $TRACE_PROGRAMS ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+    grep 'TTL=0' "$TRACE_DIR/a.txt" | head -5
+fi
+echo ""
+
+# ============================================================
+# TESTS DE LAS COLAS DE LISTOS
+# ============================================================
+
+# Test 45: Árbol rojo-negro, montículo y skip list
+echo -e "${YELLOW}[46/46] Test 45: Árbol rojo-negro, montículo y skip list${NC}"
+echo "Parámetros: make test (inserciones y borrados aleatorios)"
+make test > /dev/null 2>&1
+if [ $? -eq 0 ]; then
+    echo -e "${GREEN}✓ Test completado${NC}"
+else
+    echo -e "${RED}✗ Test falló${NC}"
+fi
+echo ""
+
 echo -e "${BLUE}========================================${NC}"
 echo -e "${GREEN}   ✓ Todos los tests completados${NC}"
 echo -e "${BLUE}========================================${NC}"
 echo ""
 echo -e "${YELLOW}Flags disponibles:${NC}"
-echo -e "  -f <hz>          Clock frequency (default: 1)"
+echo -e "  -f <hz|max>      Clock frequency (sufijos k/M/G), max=tiempo virtual (default: 1)"
 echo -e "  -q <ticks>       Quantum (default: 3)"
-echo -e "  -policy <num>    0=RR, 1=BFS, 2=Prioridades (default: 0)"
+echo -e "  -policy <num>    0=RR, 1=BFS, 2=Prioridades, 3=RR por core, 4=MuQSS, 5=CFS, 6=MLFQ, 7=SRPT (default: 0)"
 echo -e "  -sync <mode>     0=Clock, 1=Timer (default: 0)"
+echo -e "  -cfslat <ticks>  Latencia objetivo de CFS, -q es la granularidad mínima (default: 24)"
+echo -e "  -boost <ticks>   Intervalo del boost de MLFQ, 0=nunca (default: 100)"
 echo -e "  -qsize <num>     Cola de procesos (default: 100)"
 echo -e "  -cpus <num>      Número de CPUs (default: 1)"
 echo -e "  -cores <num>     Cores por CPU (default: 2)"
-echo -e "  -threads <num>   Threads por core (default: 4)"
+echo -e "  -threads <num>   Threads por core, máx. 64 (default: 4)"
 echo -e "  -t <num>         Número de timers (default: 1)"
 echo -e "  -timeri <ticks>  Intervalo del timer (default: 5)"
+echo -e "  -par <mode>      0=Serie, 1=Un worker por core (default: 0)"
+echo -e "  -dcache <0|1>    Caché de instrucciones decodificadas (default: 1)"
+echo -e "  -interp <mode>   0=Switch, 1=Threaded por bloques (default: 1)"
+echo -e "  -jit <0|1>       JIT de bloques a x86-64 (default: 0)"
+echo -e "  -fuse <0|1>      Superinstrucciones LD/LD/ADD/ST (default: 1)"
+echo -e "  -ipc <num>        Instrucciones por tick y HardwareThread (default: 1)"
+echo -e "  -corecap <num>    Máximo de instrucciones por tick y core, 0=sin límite"
+echo -e "  -tlb <num>        Entradas del TLB, 0=sin TLB (default: 16)"
+echo -e "  -tlbways <num>    Asociatividad del TLB, 0=total (default: 0)"
+echo -e "  -tlbpolicy <num>  Reemplazo del TLB: 0=RR, 1=LRU, 2=Aleatorio (default: 0)"
+echo -e "  -asid <0|1>       TLB etiquetado con ASID (default: 1)"
+echo -e "  -log <level>      Salida: off, summary, tick, instr (default: instr)"
+echo -e "  -des <0|1>       Saltar ticks ociosos hasta el siguiente evento (default: 0)"
+echo -e "  -tickto <ms>      Espera máxima del reloj a timers/scheduler por tick, 0=sin límite (default: 0)"
+echo -e "  -nohz <0|1>      Tickless: scheduler/timers ociosos duermen hasta su evento (default: 0)"
 echo ""
 echo -e "${YELLOW}Ejemplo de uso:${NC}"
 echo -e "  ./kernel -q 5 -policy 1 -sync 0 -f 3"
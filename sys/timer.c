@@ -1,87 +1,253 @@
 #include "timer.h"
 #include "clock.h"
+#include "log.h"
+#include "event.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-// Timer waits for {interval} clock ticks and generates an interruption
-void* timer_function(void* arg) {
-    Timer* timer = (Timer*)arg;
-    
-    while (timer->running && running) {
-        pthread_mutex_lock(&clk_mutex);
-        
+// Every timer lives in one slot of the wheel. Each slot is a circular list
+// with a sentinel node, so inserting and cancelling a timer is O(1).
+// The wheel, the expired list and the timers' links are protected by clk_mutex.
+static Timer wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SIZE];
+static Timer expired;           // Timers due on the tick being dispatched
+static int wheel_tick = 0;      // Next tick the wheel has to process
+static int wheel_timers = 0;    // Timers armed (in the wheel or expired)
+
+// Dispatcher: the only tick consumer of the timer service
+static pthread_t dispatcher_thread;
+static int dispatcher_running = 0;
+static int dispatcher_participant = -1;  // Its id in the clock's tick barrier
+static int dispatcher_start_tick = 0;
+static int num_timers = 0;      // Timers created and not destroyed yet
+static Timer* dispatching = NULL;  // Timer whose callback runs outside clk_mutex
+static pthread_cond_t dispatch_cond = PTHREAD_COND_INITIALIZER;
+
+static void timer_list_init(Timer* head) {
+    head->prev = head;
+    head->next = head;
+}
+
+static void timer_list_add(Timer* head, Timer* timer) {
+    timer->prev = head->prev;
+    timer->next = head;
+    head->prev->next = timer;
+    head->prev = timer;
+}
+
+static void timer_list_del(Timer* timer) {
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    timer->prev = NULL;
+    timer->next = NULL;
+}
+
+// Put a timer in the slot of its expiry tick, at the lowest level that reaches it
+static void wheel_add(Timer* timer) {
+    int delta = timer->expires - wheel_tick;
+    int level = 0;
+    int tick = timer->expires;
+
+    if (delta < 0) {
+        tick = wheel_tick;  // Already due: next tick processed
+    } else if (delta >= 1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) {
+        delta = (1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+        tick = wheel_tick + delta;  // Beyond the wheel: re-filed when the top level cascades
+    }
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= 1 << (TIMER_WHEEL_BITS * (level + 1))) {
+        level++;
+    }
+
+    int slot = (tick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SIZE - 1);
+    timer_list_add(&wheel[level][slot], timer);
+    wheel_timers++;
+}
+
+// Re-file the timers of one slot of an upper level into the levels below
+static void wheel_cascade(int level, int slot) {
+    Timer* head = &wheel[level][slot];
+    while (head->next != head) {
+        Timer* timer = head->next;
+        timer_list_del(timer);
+        wheel_timers--;
+        wheel_add(timer);
+    }
+}
+
+// Process the wheel up to 'tick': timers due move to the expired list
+static void wheel_advance(int tick) {
+    if (wheel_timers == 0) {
+        wheel_tick = tick + 1;  // Nothing to fire or cascade
+        return;
+    }
+
+    while (wheel_tick <= tick) {
+        int t = wheel_tick;
+        int slot = t & (TIMER_WHEEL_SIZE - 1);
+
+        // Each time a level wraps around, bring down the next slot of the level above
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            if (((t >> (TIMER_WHEEL_BITS * (level - 1))) & (TIMER_WHEEL_SIZE - 1)) != 0) break;
+            wheel_cascade(level, (t >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SIZE - 1));
+        }
+
+        Timer* head = &wheel[0][slot];
+        while (head->next != head) {
+            Timer* timer = head->next;
+            timer_list_del(timer);
+            timer_list_add(&expired, timer);
+        }
+        wheel_tick++;
+    }
+}
+
+// Arm a timer for its next interruption
+static void timer_arm(Timer* timer) {
+    int interval = timer->interval > 0 ? timer->interval : 1;
+    timer->expires = timer->last_tick + interval;
+    wheel_add(timer);
+    if (DES_ENABLED || TICKLESS_ENABLED) {
+        clock_schedule_event(timer->expires, EVENT_TIMER, timer->id);
+    }
+}
+
+// Dispatcher waits for each clock tick and fires the timers due on it
+static void* timer_dispatcher_function(void* arg) {
+    (void)arg; // Unused parameter
+
+    pthread_mutex_lock(&clk_mutex);
+    int seen_tick = dispatcher_start_tick;
+    while (dispatcher_running && running) {
         // Patrón R: Esperar tick del reloj (cond_wait)
-        pthread_cond_wait(&clk_cond, &clk_mutex);
-        
-        if (!timer->running || !running) {
-            // Señalizar antes de salir para no bloquear al reloj
-            pthread_cond_broadcast(&clk_cond2);
-            pthread_mutex_unlock(&clk_mutex);
+        while (dispatcher_running && running && clk_counter == seen_tick) {
+            pthread_cond_wait(&clk_cond, &clk_mutex);
+        }
+
+        if (!dispatcher_running || !running) {
             break;
         }
-        
-        // Verificar si se cumple el intervalo del timer
-        if ((clk_counter - timer->last_tick) >= timer->interval) {
-            // Generate timer interruption
+        seen_tick = clk_counter;
+        wheel_advance(clk_counter);
+
+        // Generate the interruptions, re-arming each timer before it fires
+        while (expired.next != &expired) {
+            Timer* timer = expired.next;
+            timer_list_del(timer);
+            wheel_timers--;
             timer->last_tick = clk_counter;
-            
+            timer_arm(timer);
+
             // Only print message if timer doesn't have a callback (not used for scheduler sync)
             if (!timer->callback) {
-                printf("[Timer] Timer %d interrupted at tick %d (interval=%d)\n", 
-                       timer->id, clk_counter, timer->interval);
-                fflush(stdout);
+                LOG_EVENT(LOG_LEVEL_TICK, "[Timer] Timer %d interrupted at tick %d (interval=%d)\n",
+                          timer->id, clk_counter, timer->interval);
+                continue;
             }
-            
-            // Patrón R: Señalizar al reloj que puede continuar (cond_broadcast con cond2)
-            pthread_cond_broadcast(&clk_cond2);
-            
-            pthread_mutex_unlock(&clk_mutex);
-            
-            // Execute callback if provided (outside clk_mutex to avoid deadlock)
-            if (timer->callback) {
-                timer->callback(timer->id, timer->user_data);
-            }
-        } else {
-            // No se cumple el intervalo, pero igual debemos señalizar al reloj
-            pthread_cond_broadcast(&clk_cond2);
+
+            // Execute callback outside clk_mutex to avoid deadlock. The tick is acked
+            // afterwards: the clock waits for the work it triggers.
+            dispatching = timer;
             pthread_mutex_unlock(&clk_mutex);
+            timer->callback(timer->id, timer->user_data);
+            pthread_mutex_lock(&clk_mutex);
+            dispatching = NULL;
+            pthread_cond_broadcast(&dispatch_cond);
+        }
+
+        // Patrón R: Señalizar al reloj que puede continuar (cond_broadcast con cond2)
+        clock_tick_arrive(dispatcher_participant, seen_tick);
+        
+        // Tickless idle: sleep until the clock pops the next timer event
+        if (TICKLESS_ENABLED) {
+            seen_tick = clock_tick_idle(dispatcher_participant, EVENT_TIMER, &dispatcher_running) - 1;
         }
     }
+
+    // Señalizar antes de salir para no bloquear al reloj
+    clock_leave_tick_barrier(dispatcher_participant);
+    pthread_mutex_unlock(&clk_mutex);
     return NULL;
 }
 
-// Create a new timer struct (including thread) with given parameters
+// Start the dispatcher with the first timer. Called with clk_mutex held.
+static int timer_service_start(void) {
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SIZE; slot++) {
+            timer_list_init(&wheel[level][slot]);
+        }
+    }
+    timer_list_init(&expired);
+    wheel_timers = 0;
+
+    // Join before the thread exists so the clock waits for it from the next tick on
+    dispatcher_participant = clock_join_tick_barrier("Timer dispatcher", &dispatcher_start_tick);
+    if (dispatcher_participant < 0) return -1;
+    wheel_tick = dispatcher_start_tick + 1;
+    dispatcher_running = 1;
+
+    int ret = pthread_create(&dispatcher_thread, NULL, timer_dispatcher_function, NULL);
+    if (ret != 0) {
+        fprintf(stderr, "Error creating timer dispatcher thread: %s\n", strerror(ret));
+        clock_leave_tick_barrier(dispatcher_participant);
+        dispatcher_running = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// Create a new timer and arm it in the timing wheel
 Timer* create_timer(int id, int interval, timer_callback_t callback, void* user_data) {
     Timer* timer = malloc(sizeof(Timer));
     if (!timer) return NULL;
 
     timer->id = id;
     timer->interval = interval;
-    timer->last_tick = clk_counter;
-    timer->running = 1;
     timer->callback = callback;
     timer->user_data = user_data;
+    timer->prev = NULL;
+    timer->next = NULL;
 
-    int ret = pthread_create(&timer->thread, NULL, timer_function, (void*)timer);
-    if (ret != 0) {
-        printf("Error creating timer thread: %s\n", strerror(ret));
+    pthread_mutex_lock(&clk_mutex);
+    if (num_timers == 0 && timer_service_start() != 0) {
+        pthread_mutex_unlock(&clk_mutex);
         free(timer);
         return NULL;
     }
-    
+    num_timers++;
+    timer->last_tick = clk_counter;
+    timer_arm(timer);
+    pthread_mutex_unlock(&clk_mutex);
+
     return timer;
 }
 
-// Destroy timer and free memory
+// Cancel a timer and free memory. The last one stops the dispatcher.
 void destroy_timer(Timer* timer) {
-    if (timer) {
-        pthread_mutex_lock(&clk_mutex);
-        timer->running = 0;
-        pthread_cond_broadcast(&clk_cond);  // Wake up the timer
-        pthread_mutex_unlock(&clk_mutex);
-        
-        pthread_join(timer->thread, NULL);
-        free(timer);
+    if (!timer) return;
+
+    pthread_mutex_lock(&clk_mutex);
+    // Its callback may be running right now
+    while (dispatching == timer) {
+        pthread_cond_wait(&dispatch_cond, &clk_mutex);
+    }
+    if (timer->next) {
+        timer_list_del(timer);
+        wheel_timers--;
+    }
+    if (DES_ENABLED || TICKLESS_ENABLED) {
+        clock_cancel_events(EVENT_TIMER, timer->id);
+    }
+    free(timer);
+
+    int stop = (--num_timers == 0);
+    if (stop) {
+        dispatcher_running = 0;
+        pthread_cond_broadcast(&clk_cond);  // Wake up the dispatcher
+        pthread_cond_broadcast(&clk_idle_cond);
+    }
+    pthread_mutex_unlock(&clk_mutex);
+
+    if (stop) {
+        pthread_join(dispatcher_thread, NULL);
     }
 }
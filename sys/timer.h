@@ -9,20 +9,27 @@ extern volatile int running;
 // Callback function type for timer interrupts
 typedef void (*timer_callback_t)(int timer_id, void* user_data);
 
-// Timer structure
-typedef struct {
+// Timer structure. Timers have no thread of their own: they sit in the timing
+// wheel and a single dispatcher thread fires them (see timer.c)
+typedef struct Timer {
     int id;
     int interval;    // Interval of clock ticks after which interrupts
     int last_tick;   // Last processed clock tick
-    pthread_t thread;
-    volatile int running;  // Flag to control timer execution
+    int expires;     // Tick of the next interruption
+    struct Timer* prev;  // Links in its wheel slot (or in the expired list)
+    struct Timer* next;
     timer_callback_t callback;  // Callback function to execute on interrupt
     void* user_data;            // User data to pass to callback
 } Timer;
 
+// Hierarchical timing wheel: level 0 has one slot per tick, every level above
+// covers 64 times the ticks of the one below (2^24 ticks in total)
+#define TIMER_WHEEL_BITS   6
+#define TIMER_WHEEL_SIZE   (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+
 // Function declarations
 Timer* create_timer(int id, int interval, timer_callback_t callback, void* user_data);
 void destroy_timer(Timer* timer);
-void* timer_function(void* arg);
 
 #endif // TIMER_H
@@ -0,0 +1,154 @@
+#include "tlb.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Default geometry: 16 entries, fully associative, round robin
+int TLB_ENTRIES = 16;
+int TLB_WAYS = 0;
+int TLB_POLICY = TLB_POLICY_RR;
+int TLB_ASID_ENABLED = 1;
+
+// Initialize an empty TLB with the configured geometry
+// Returns 0 on success, -1 on error
+int tlb_init(TLB* tlb) {
+    if (!tlb) return -1;
+
+    tlb->entries = NULL;
+    tlb->next_replace = NULL;
+    tlb->num_entries = TLB_ENTRIES > 0 ? TLB_ENTRIES : 0;
+    tlb->ways = (TLB_WAYS > 0 && TLB_WAYS <= tlb->num_entries) ? TLB_WAYS : tlb->num_entries;
+    tlb->num_sets = 0;
+    tlb->policy = TLB_POLICY;
+    tlb->asid = 0;
+    tlb->use_counter = 0;
+    tlb->seed = (unsigned int)(uintptr_t)tlb;
+    tlb->hits = 0;
+    tlb->misses = 0;
+    tlb->flushes_avoided = 0;
+
+    if (tlb->num_entries == 0) return 0;  // No TLB: every translation walks the page table
+
+    if (tlb->num_entries % tlb->ways != 0) {
+        fprintf(stderr, "Error: TLB entries (%d) must be a multiple of its ways (%d)\n",
+                tlb->num_entries, tlb->ways);
+        return -1;
+    }
+    tlb->num_sets = tlb->num_entries / tlb->ways;
+
+    tlb->entries = calloc(tlb->num_entries, sizeof(TLBEntry));
+    tlb->next_replace = calloc(tlb->num_sets, sizeof(int));
+    if (!tlb->entries || !tlb->next_replace) {
+        tlb_destroy(tlb);
+        return -1;
+    }
+    return 0;
+}
+
+// Free the entries of a TLB
+void tlb_destroy(TLB* tlb) {
+    if (tlb) {
+        free(tlb->entries);
+        free(tlb->next_replace);
+        tlb->entries = NULL;
+        tlb->next_replace = NULL;
+        tlb->num_entries = 0;
+        tlb->num_sets = 0;
+    }
+}
+
+// Invalidate every entry
+void tlb_flush(TLB* tlb) {
+    if (!tlb) return;
+    for (int i = 0; i < tlb->num_entries; i++) {
+        tlb->entries[i].valid = 0;
+    }
+    for (int s = 0; s < tlb->num_sets; s++) {
+        tlb->next_replace[s] = 0;
+    }
+}
+
+// Context switch to another address space.
+// With ASIDs the entries of other processes stay (they don't match the new ASID);
+// without them every switch flushes the TLB.
+void tlb_switch_asid(TLB* tlb, uint32_t asid) {
+    if (!tlb) return;
+    if (!TLB_ASID_ENABLED) {
+        tlb_flush(tlb);
+    } else if (tlb->num_entries > 0) {
+        tlb->flushes_avoided++;
+    }
+    tlb->asid = asid;
+}
+
+// Invalidate the entries of one address space (its page table was destroyed)
+// Returns the number of entries invalidated
+int tlb_invalidate_asid(TLB* tlb, uint32_t asid) {
+    int count = 0;
+    if (!tlb) return 0;
+    for (int i = 0; i < tlb->num_entries; i++) {
+        if (tlb->entries[i].valid && tlb->entries[i].asid == asid) {
+            tlb->entries[i].valid = 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+// Look up a virtual page of the current address space.
+// Returns 1 and sets *physical_frame on a hit, 0 on a miss
+int tlb_lookup(TLB* tlb, uint32_t virtual_page, uint32_t* physical_frame) {
+    if (tlb->num_sets > 0) {
+        TLBEntry* set = &tlb->entries[(virtual_page % tlb->num_sets) * tlb->ways];
+        for (int w = 0; w < tlb->ways; w++) {
+            if (set[w].valid && set[w].virtual_page == virtual_page && set[w].asid == tlb->asid) {
+                set[w].last_used = ++tlb->use_counter;
+                *physical_frame = set[w].physical_frame;
+                tlb->hits++;
+                return 1;
+            }
+        }
+    }
+    tlb->misses++;
+    return 0;
+}
+
+// Insert a translation after a miss, replacing a victim of its set if it is full
+void tlb_insert(TLB* tlb, uint32_t virtual_page, uint32_t physical_frame) {
+    if (tlb->num_sets == 0) return;
+
+    int set_idx = virtual_page % tlb->num_sets;
+    TLBEntry* set = &tlb->entries[set_idx * tlb->ways];
+    int victim = -1;
+
+    // Free way first
+    for (int w = 0; w < tlb->ways; w++) {
+        if (!set[w].valid) {
+            victim = w;
+            break;
+        }
+    }
+
+    if (victim < 0) {
+        switch (tlb->policy) {
+            case TLB_POLICY_LRU:
+                victim = 0;
+                for (int w = 1; w < tlb->ways; w++) {
+                    if (set[w].last_used < set[victim].last_used) victim = w;
+                }
+                break;
+            case TLB_POLICY_RANDOM:
+                victim = rand_r(&tlb->seed) % tlb->ways;
+                break;
+            default:  // TLB_POLICY_RR
+                victim = tlb->next_replace[set_idx];
+                tlb->next_replace[set_idx] = (victim + 1) % tlb->ways;
+                break;
+        }
+    }
+
+    set[victim].virtual_page = virtual_page;
+    set[victim].physical_frame = physical_frame;
+    set[victim].last_used = ++tlb->use_counter;
+    set[victim].asid = tlb->asid;
+    set[victim].valid = 1;
+}
@@ -0,0 +1,52 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include <stdint.h>
+
+// Replacement policies
+#define TLB_POLICY_RR     0  // Round robin per set (default)
+#define TLB_POLICY_LRU    1  // Least recently used
+#define TLB_POLICY_RANDOM 2  // Random victim
+
+// Geometry of every hardware thread TLB (set from the command line)
+extern int TLB_ENTRIES;  // Total entries, 0 = no TLB (always walk the page table)
+extern int TLB_WAYS;     // Associativity, 0 = fully associative
+extern int TLB_POLICY;   // Replacement policy
+extern int TLB_ASID_ENABLED;  // 1 = ASID-tagged entries survive context switches (default)
+
+// TLB Entry structure
+typedef struct {
+    uint32_t virtual_page;   // Virtual page number
+    uint32_t physical_frame; // Physical frame number
+    uint32_t last_used;      // Last use stamp (LRU)
+    uint32_t asid;           // Address space the translation belongs to
+    uint8_t valid;           // Valid bit (1 = entry is valid)
+} TLBEntry;
+
+// Translation Lookaside Buffer (TLB)
+// Set-associative: set s holds entries[s * ways .. s * ways + ways - 1]
+typedef struct {
+    TLBEntry* entries;
+    int* next_replace;       // Round-robin victim of each set
+    int num_entries;
+    int ways;
+    int num_sets;
+    int policy;
+    uint32_t asid;           // Address space of the running process
+    uint32_t use_counter;    // Source of LRU stamps
+    unsigned int seed;       // Random replacement state
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long flushes_avoided;  // Context switches that kept the entries
+} TLB;
+
+// Function declarations
+int tlb_init(TLB* tlb);      // Geometry from TLB_ENTRIES/TLB_WAYS/TLB_POLICY
+void tlb_destroy(TLB* tlb);
+void tlb_flush(TLB* tlb);
+void tlb_switch_asid(TLB* tlb, uint32_t asid);  // Context switch (flushes without ASIDs)
+int tlb_invalidate_asid(TLB* tlb, uint32_t asid);  // Drop one address space, returns entries dropped
+int tlb_lookup(TLB* tlb, uint32_t virtual_page, uint32_t* physical_frame);  // 1 = hit
+void tlb_insert(TLB* tlb, uint32_t virtual_page, uint32_t physical_frame);
+
+#endif // TLB_H